@@ -0,0 +1,201 @@
+#include "core/deck.hpp"
+#include "core/hand.hpp"
+#include "core/hand_evaluator.hpp"
+#include "core/hand_ranking.hpp"
+#include "core/models/player.hpp"
+#include "core/pot.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Core library microbenchmarks. Build with -DBUILD_BENCHMARKS=ON
+// -DCMAKE_BUILD_TYPE=Release; `make bench_core_json` writes bench_core.json.
+
+namespace {
+
+constexpr int NUM_HANDS = 4096;
+
+std::vector<std::vector<Card>> randomHands(std::size_t cards_per_hand) {
+    std::mt19937 rng(42);
+    std::vector<int> deck(NUM_CARDS);
+    std::vector<std::vector<Card>> hands;
+    hands.reserve(NUM_HANDS);
+    for (int i = 0; i < NUM_HANDS; ++i) {
+        for (int j = 0; j < NUM_CARDS; ++j) deck[j] = j;
+        std::shuffle(deck.begin(), deck.end(), rng);
+        std::vector<Card> hand;
+        for (std::size_t k = 0; k < cards_per_hand; ++k) {
+            hand.emplace_back(static_cast<Rank>(deck[k] / NUM_SUITS), static_cast<Suit>(deck[k] % NUM_SUITS));
+        }
+        hands.push_back(std::move(hand));
+    }
+    return hands;
+}
+
+std::vector<CardSet> randomCardSets(std::size_t cards_per_hand) {
+    std::vector<CardSet> sets;
+    for (const auto& hand : randomHands(cards_per_hand)) {
+        sets.emplace_back(hand);
+    }
+    return sets;
+}
+
+Player makePlayer(const std::string& id, int seat) {
+    return Player{id, id, common::constants::STARTING_STACK, seat, {}, ConnectionStatus::CONNECTED, 0, std::nullopt,
+                  false};
+}
+
+// Amount the player to act must add to match the highest bet
+int callAmount(const Hand& hand, const Player* player) {
+    int max_bet = 0;
+    int player_bet = 0;
+    for (std::size_t i = 0; i < hand.players.size() && i < hand.player_bets.size(); ++i) {
+        max_bet = std::max(max_bet, hand.player_bets[i]);
+        if (hand.players[i] == player) player_bet = hand.player_bets[i];
+    }
+    return std::min(max_bet - player_bet, player->stack);
+}
+
+void BM_DeckShuffle(benchmark::State& state) {
+    Deck deck;
+    for (auto _ : state) {
+        deck.shuffle();
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_DeckShuffle);
+
+// Shuffle plus a heads-up deal: two hole cards each and a five-card board
+void BM_DeckDeal(benchmark::State& state) {
+    Deck deck;
+    for (auto _ : state) {
+        deck.shuffle();
+        for (int i = 0; i < 9; ++i) {
+            benchmark::DoNotOptimize(deck.deal());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 9);
+}
+BENCHMARK(BM_DeckDeal);
+
+void BM_HandRankingEvaluate(benchmark::State& state) {
+    auto hands = randomHands(static_cast<std::size_t>(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HandRanking::evaluate(hands[i++ % hands.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HandRankingEvaluate)->DenseRange(5, 7);
+
+void BM_HandEvaluatorCardSet(benchmark::State& state) {
+    auto sets = randomCardSets(static_cast<std::size_t>(state.range(0)));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HandEvaluator::evaluate(sets[i++ % sets.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HandEvaluatorCardSet)->DenseRange(5, 7);
+
+void BM_HandRankingEvaluateBatch(benchmark::State& state) {
+    auto sets = randomCardSets(static_cast<std::size_t>(state.range(0)));
+    std::vector<HandStrength> results(sets.size());
+    for (auto _ : state) {
+        HandRanking::evaluateBatch(sets, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sets.size()));
+}
+BENCHMARK(BM_HandRankingEvaluateBatch)->DenseRange(5, 7);
+
+void BM_HandRankingCompare(benchmark::State& state) {
+    auto hands = randomHands(7);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HandRanking::compare(hands[i % hands.size()], hands[(i + 1) % hands.size()]));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HandRankingCompare);
+
+void BM_CalculateSidePots(benchmark::State& state) {
+    std::vector<Player> seats;
+    for (int i = 0; i < 6; ++i) {
+        seats.push_back(makePlayer("player" + std::to_string(i), i));
+    }
+    std::vector<Player*> players;
+    for (auto& seat : seats) players.push_back(&seat);
+    const std::vector<int> bets = {40, 120, 120, 400, 75, 400};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pot::calculateSidePots(players, bets));
+    }
+}
+BENCHMARK(BM_CalculateSidePots);
+
+// One preflop call per iteration. Hands are dealt in batches with the timer
+// paused, so the pause and resume cost is paid once per batch, not per call.
+void BM_ApplyAction(benchmark::State& state) {
+    constexpr std::size_t BATCH = 256;
+    std::vector<Player> players;
+    for (std::size_t i = 0; i < BATCH; ++i) {
+        players.push_back(makePlayer("player1", common::constants::SEAT_1));
+        players.push_back(makePlayer("player2", common::constants::SEAT_2));
+    }
+    std::vector<Hand> hands(BATCH);
+    std::vector<Player*> actors(BATCH);
+    std::vector<int> amounts(BATCH);
+    Deck deck;
+    auto deal = [&] {
+        for (std::size_t i = 0; i < BATCH; ++i) {
+            Player& player1 = players[2 * i];
+            Player& player2 = players[2 * i + 1];
+            player1.stack = player2.stack = common::constants::STARTING_STACK;
+            poker::startHand(hands[i], deck, &player1, &player1, &player2);
+            actors[i] = hands[i].current_player_to_act;
+            amounts[i] = callAmount(hands[i], actors[i]);
+        }
+    };
+    std::size_t next = BATCH;
+    for (auto _ : state) {
+        if (next == BATCH) {
+            state.PauseTiming();
+            deal();
+            next = 0;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(poker::applyAction(hands[next], actors[next], Action::CALL, amounts[next]));
+        ++next;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ApplyAction);
+
+// Deal and play a heads-up hand to completion, calling or checking every street
+void BM_SimulatedHand(benchmark::State& state) {
+    Player player1 = makePlayer("player1", common::constants::SEAT_1);
+    Player player2 = makePlayer("player2", common::constants::SEAT_2);
+    Deck deck;
+    for (auto _ : state) {
+        player1.stack = player2.stack = common::constants::STARTING_STACK;
+        Hand hand;
+        poker::startHand(hand, deck, &player1, &player1, &player2);
+        for (int step = 0; step < 100 && !poker::isHandComplete(hand); ++step) {
+            Player* actor = hand.current_player_to_act;
+            if (actor == nullptr) break;
+            if (!poker::applyAction(hand, actor, Action::CALL, callAmount(hand, actor))) {
+                poker::applyAction(hand, actor, Action::FOLD, 0);
+            }
+        }
+        benchmark::DoNotOptimize(hand.winners.data());
+    }
+}
+BENCHMARK(BM_SimulatedHand);
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
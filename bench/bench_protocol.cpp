@@ -0,0 +1,310 @@
+#include "core/hand.hpp"
+#include "server/game_session.hpp"
+#include "server/in_memory_transport.hpp"
+#include "server/client_message.hpp"
+#include "server/message_writer.hpp"
+#include "server/heartbeat_sweeper.hpp"
+#include "server/metrics.hpp"
+#include "common/logging.hpp"
+#include <benchmark/benchmark.h>
+#include <boost/asio.hpp>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+// Protocol-level benchmarks: GameSession driven through InMemoryTransport, so
+// the numbers cover JSON parsing, game logic and serialization but no sockets
+// or WebSocket framing. Build with -DBUILD_BENCHMARKS=ON.
+
+namespace {
+std::atomic<std::size_t> g_allocations{0};
+} // anonymous namespace
+
+// Count heap allocations so the benchmarks can report them per operation
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+struct Client {
+    std::shared_ptr<InMemoryTransport> transport = std::make_shared<InMemoryTransport>();
+    std::string player_id;
+};
+
+// Run the work the transports handed to the table's strand
+void settle(boost::asio::io_context& ioc) {
+    ioc.restart();
+    ioc.poll();
+}
+
+Client connect(boost::asio::io_context& ioc, const std::shared_ptr<GameSession>& game) {
+    Client client;
+    client.transport->setHandler(game);
+    client.transport->start();
+    settle(ioc);
+    std::string welcome;
+    client.transport->receive(welcome);
+    client.player_id = nlohmann::json::parse(welcome)["payload"]["player_id"].get<std::string>();
+    return client;
+}
+
+// One ping/pong round trip
+void BM_PingPong(benchmark::State& state) {
+    common::log::setMinLevel(common::log::Level::ERROR);
+    boost::asio::io_context ioc;
+    auto game = std::make_shared<GameSession>(ioc);
+    Client client = connect(ioc, game);
+    const std::string ping = R"({"type":"ping","payload":{}})";
+    std::string reply;
+    for (auto _ : state) {
+        client.transport->deliver(ping);
+        settle(ioc);
+        client.transport->receive(reply);
+        benchmark::DoNotOptimize(reply.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PingPong);
+
+// A table from connect to hand_completed: welcome, two joins, hand_started and
+// a fold, with every server message taken off the transports
+void BM_ProtocolHand(benchmark::State& state) {
+    common::log::setMinLevel(common::log::Level::ERROR);
+    boost::asio::io_context ioc;
+    for (auto _ : state) {
+        auto game = std::make_shared<GameSession>(ioc);
+        Client alice = connect(ioc, game);
+        Client bob = connect(ioc, game);
+        alice.transport->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+        bob.transport->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+        settle(ioc);
+        alice.transport->drain();
+        auto messages = bob.transport->drain();
+        auto started = nlohmann::json::parse(messages.back())["payload"];
+        Client& actor = started["current_player_to_act"] == alice.player_id ? alice : bob;
+        nlohmann::json fold = {{"type", "action"},
+                               {"payload", {{"hand_id", started["hand_id"]}, {"action", "fold"}, {"amount", 0}}}};
+        actor.transport->deliver(fold.dump());
+        settle(ioc);
+        benchmark::DoNotOptimize(alice.transport->drain());
+        benchmark::DoNotOptimize(bob.transport->drain());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProtocolHand);
+
+// Broadcast fan-out of a deciding fold: action_applied and hand_completed go
+// to both players, each serialized once into a buffer both outboxes share.
+// Reports heap allocations per action and how many payload buffers the two
+// clients received against how many messages.
+void BM_BroadcastHand(benchmark::State& state) {
+    common::log::setMinLevel(common::log::Level::ERROR);
+    boost::asio::io_context ioc;
+    std::size_t allocations = 0;
+    std::size_t messages = 0;
+    std::size_t buffers = 0;
+    for (auto _ : state) {
+        auto game = std::make_shared<GameSession>(ioc);
+        Client alice = connect(ioc, game);
+        Client bob = connect(ioc, game);
+        alice.transport->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+        bob.transport->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+        settle(ioc);
+        auto started = nlohmann::json::parse(*bob.transport->drainPayloads().back())["payload"];
+        alice.transport->drainPayloads();
+        Client& actor = started["current_player_to_act"] == alice.player_id ? alice : bob;
+        std::string fold = nlohmann::json{{"type", "action"},
+                                          {"payload", {{"hand_id", started["hand_id"]}, {"action", "fold"}, {"amount", 0}}}}
+                               .dump();
+
+        // Measured part: one action and its broadcasts
+        std::size_t before = g_allocations.load(std::memory_order_relaxed);
+        actor.transport->deliver(fold);
+        settle(ioc);
+        auto to_alice = alice.transport->drainPayloads();
+        auto to_bob = bob.transport->drainPayloads();
+        allocations += g_allocations.load(std::memory_order_relaxed) - before;
+
+        std::set<const std::string*> distinct;
+        for (const auto* outbox : {&to_alice, &to_bob}) {
+            for (const auto& payload : *outbox) {
+                distinct.insert(payload.get());
+            }
+        }
+        messages += to_alice.size() + to_bob.size();
+        buffers += distinct.size();
+    }
+    double iterations = static_cast<double>(state.iterations());
+    state.counters["allocs_per_action"] = static_cast<double>(allocations) / iterations;
+    state.counters["messages_per_action"] = static_cast<double>(messages) / iterations;
+    state.counters["buffers_per_action"] = static_cast<double>(buffers) / iterations;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BroadcastHand);
+
+const char* const ACTION_MESSAGE =
+    R"({"type":"action","payload":{"hand_id":"hand_123456","action":"raise","amount":120}})";
+
+// Inbound parse of an action as handleMessage did it before typed dispatch: a
+// full DOM, then field lookups by name
+void BM_ParseActionDom(benchmark::State& state) {
+    std::string text = ACTION_MESSAGE;
+    std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        nlohmann::json json = nlohmann::json::parse(text);
+        const nlohmann::json& payload = json.at("payload");
+        std::string type = json.at("type").get<std::string>();
+        std::string hand_id = payload.at("hand_id").get<std::string>();
+        std::optional<Action> action = parseAction(payload.at("action").get<std::string>());
+        int amount = payload.at("amount").get<int>();
+        benchmark::DoNotOptimize(type);
+        benchmark::DoNotOptimize(hand_id);
+        benchmark::DoNotOptimize(action);
+        benchmark::DoNotOptimize(amount);
+    }
+    state.counters["allocs_per_message"] =
+        static_cast<double>(g_allocations.load(std::memory_order_relaxed) - before) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_ParseActionDom);
+
+// The same message through parseClientMessage's single SAX pass
+void BM_ParseActionSax(benchmark::State& state) {
+    std::string text = ACTION_MESSAGE;
+    std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        ClientMessage message = parseClientMessage(text);
+        benchmark::DoNotOptimize(message);
+    }
+    state.counters["allocs_per_message"] =
+        static_cast<double>(g_allocations.load(std::memory_order_relaxed) - before) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_ParseActionSax);
+
+// Outbound action_applied as the broadcast builders produced it before the
+// direct writer: a DOM per message, dumped to a string, then shared
+void BM_SerializeActionAppliedDom(benchmark::State& state) {
+    std::string table_id = "table-1";
+    std::string player_id = "player-0123456789";
+    std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        nlohmann::json message = {
+            {"type", "action_applied"},
+            {"payload", {
+                {"hand_id", poker::formatHandId(123456)},
+                {"player_id", player_id},
+                {"action", actionName(Action::RAISE)},
+                {"amount", 120},
+                {"new_stack", 280},
+                {"pot", 246},
+                {"next_player_to_act", player_id}
+            }}
+        };
+        message["table_id"] = table_id;
+        Transport::Payload payload = std::make_shared<const std::string>(message.dump());
+        benchmark::DoNotOptimize(payload);
+    }
+    state.counters["allocs_per_message"] =
+        static_cast<double>(g_allocations.load(std::memory_order_relaxed) - before) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_SerializeActionAppliedDom);
+
+// The same message written straight into a reused buffer by messages::actionApplied
+void BM_SerializeActionAppliedWriter(benchmark::State& state) {
+    std::string table_id = "table-1";
+    std::string player_id = "player-0123456789";
+    std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        Transport::Payload payload =
+            messages::actionApplied(table_id, 123456, player_id, Action::RAISE, 120, 280, 246, player_id);
+        benchmark::DoNotOptimize(payload);
+    }
+    state.counters["allocs_per_message"] =
+        static_cast<double>(g_allocations.load(std::memory_order_relaxed) - before) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_SerializeActionAppliedWriter);
+
+// Keep-alive over state.range(0) connections. Each used to own a ping timer and
+// a pong timer, re-armed every interval; a sweeper walks them in buckets on one
+// timer. One iteration is a full interval's worth of sweeps.
+class IdlePeer : public HeartbeatSweeper::Peer {
+public:
+    void sendHeartbeat() override { ++pings; }
+    void checkHeartbeat() override {}
+    std::size_t pings = 0;
+};
+
+void BM_HeartbeatSweep(benchmark::State& state) {
+    boost::asio::io_context ioc;
+    // Long enough that the tick timer never fires; the benchmark sweeps by hand
+    auto sweeper = std::make_shared<HeartbeatSweeper>(ioc, std::chrono::hours(1), std::chrono::minutes(10));
+    std::vector<std::shared_ptr<IdlePeer>> peers;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        peers.push_back(std::make_shared<IdlePeer>());
+        sweeper->join(peers.back());
+    }
+    std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        for (std::size_t bucket = 0; bucket < HeartbeatSweeper::DEFAULT_BUCKETS; ++bucket) {
+            sweeper->sweep();
+        }
+    }
+    double connections = static_cast<double>(state.range(0));
+    state.counters["timers_before"] = 2 * connections;
+    state.counters["timers_after"] = 1;
+    state.counters["wakeups_per_interval_before"] = 2 * connections;
+    state.counters["wakeups_per_interval_after"] = static_cast<double>(HeartbeatSweeper::DEFAULT_BUCKETS);
+    state.counters["timer_bytes_per_connection_before"] = static_cast<double>(2 * sizeof(boost::asio::steady_timer));
+    state.counters["timer_bytes_per_connection_after"] = static_cast<double>(sizeof(HeartbeatSweeper::Peer));
+    state.counters["allocs_per_interval"] =
+        static_cast<double>(g_allocations.load(std::memory_order_relaxed) - before) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HeartbeatSweep)->Arg(50000);
+
+// Cost of the latency trace around one action: the receive, parse, handling and
+// serialization scopes plus a write's two samples, without the work they time
+void BM_TraceAction(benchmark::State& state) {
+    ClientMessage message = parseClientMessage(R"({"type":"action","payload":{"hand_id":"hand_1","action":"call","amount":0}})");
+    std::size_t before = g_allocations.load(std::memory_order_relaxed);
+    for (auto _ : state) {
+        {
+            metrics::Receiving receiving(metrics::Clock::now());
+            metrics::traceReceived(message);
+        }
+        metrics::Trace trace;
+        {
+            metrics::Handling handling(message);
+            metrics::Serializing serializing;
+            trace = metrics::currentTrace();
+        }
+        auto now = metrics::Clock::now();
+        metrics::record(metrics::Stage::WRITE, trace.type, now - message.parsed);
+        metrics::record(metrics::Stage::END_TO_END, trace.type, now - trace.received);
+    }
+    state.counters["allocs_per_message"] =
+        static_cast<double>(g_allocations.load(std::memory_order_relaxed) - before) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_TraceAction);
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
@@ -4,6 +4,8 @@
 
 RandomStrategy::RandomStrategy() : rng_(std::random_device{}()) {}
 
+RandomStrategy::RandomStrategy(uint64_t seed) : rng_(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32))) {}
+
 std::pair<std::string, int> RandomStrategy::chooseAction(
     const std::vector<std::string>& possible_actions,
     int call_amount,
@@ -34,4 +36,38 @@ std::pair<std::string, int> RandomStrategy::chooseAction(
     }
 
     return {action, amount};
-}
\ No newline at end of file
+}
+
+std::pair<Action, int> RandomStrategy::chooseAction(
+    span<const Action> possible_actions,
+    int call_amount,
+    int min_raise,
+    int max_raise) {
+
+    if (possible_actions.empty()) {
+        throw std::invalid_argument("possible_actions must not be empty");
+    }
+
+    std::uniform_int_distribution<> action_dist(0, possible_actions.size() - 1);
+    Action action = possible_actions[action_dist(rng_)];
+
+    int amount = 0;
+    switch (action) {
+        case Action::RAISE: {
+            if (min_raise > max_raise) {
+                throw std::invalid_argument("min_raise cannot exceed max_raise");
+            }
+            std::uniform_int_distribution<> raise_dist(min_raise, max_raise);
+            amount = raise_dist(rng_);
+            break;
+        }
+        case Action::CALL:
+            amount = call_amount;
+            break;
+        case Action::FOLD:
+            amount = 0;
+            break;
+    }
+
+    return {action, amount};
+}
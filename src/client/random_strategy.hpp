@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../core/betting_rules.hpp"
+#include "../core/span.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <random>
@@ -7,6 +10,7 @@
 class RandomStrategy {
 public:
     RandomStrategy();
+    explicit RandomStrategy(uint64_t seed); // reproducible choices for simulation
 
     // Choose an action given possible actions and betting context
     // Returns a pair of (action, amount). For fold/call, amount is 0.
@@ -17,6 +21,13 @@ public:
         int min_raise,
         int max_raise);
 
+    // Same choice over typed actions, for in-process play without JSON
+    std::pair<Action, int> chooseAction(
+        span<const Action> possible_actions,
+        int call_amount,
+        int min_raise,
+        int max_raise);
+
 private:
     std::mt19937 rng_;
 };
@@ -14,6 +14,12 @@ constexpr int DEFAULT_DEALER_POSITION = 0;
 constexpr int SEAT_1 = 0;
 constexpr int SEAT_2 = 1;
 
+// Fixed capacities of per-hand state (see core/models/hand.hpp)
+constexpr int MAX_SEATS = 10;
+constexpr int MAX_BOARD_CARDS = 5;
+constexpr int MAX_HOLE_CARDS = 2;
+constexpr int MAX_HAND_ACTIONS = 256;
+
 constexpr int MAX_STACK = 10000;
 constexpr int MAX_BET = 10000;
 constexpr int MAX_ACTION_TIMEOUT_MS = 300000;
@@ -1,9 +1,14 @@
 #include "logging.hpp"
+#include <atomic>
 #include <iostream>
 
 namespace common {
 namespace log {
 
+namespace {
+std::atomic<Level> min_level{Level::DEBUG};
+}
+
 void init() {
     // Nothing to initialize for now
 }
@@ -18,7 +23,14 @@ std::string levelToString(Level level) {
     }
 }
 
+void setMinLevel(Level level) {
+    min_level.store(level, std::memory_order_relaxed);
+}
+
 void log(Level level, const std::string& message) {
+    if (level < min_level.load(std::memory_order_relaxed)) {
+        return;
+    }
     std::cout << "[" << levelToString(level) << "] " << message << std::endl;
 }
 
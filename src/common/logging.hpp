@@ -15,5 +15,8 @@ enum class Level {
 void init();
 void log(Level level, const std::string& message);
 
+// Drop messages below `level` (default DEBUG: everything is written)
+void setMinLevel(Level level);
+
 } // namespace log
 } // namespace common
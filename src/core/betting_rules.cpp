@@ -2,6 +2,25 @@
 #include "../common/constants.hpp"
 #include <algorithm>
 
+const char* actionName(Action action) {
+    switch (action) {
+        case Action::FOLD:
+            return "fold";
+        case Action::CALL:
+            return "call";
+        case Action::RAISE:
+            return "raise";
+    }
+    return "unknown";
+}
+
+std::optional<Action> parseAction(std::string_view text) {
+    if (text == "fold") return Action::FOLD;
+    if (text == "call") return Action::CALL;
+    if (text == "raise") return Action::RAISE;
+    return std::nullopt;
+}
+
 bool BettingRules::isValidAction(Action action, int amount, const BettingState& round, int player_stack) {
     switch (action) {
         case Action::FOLD:
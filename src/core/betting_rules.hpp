@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <vector>
 #include <string>
+#include <string_view>
 
 enum class Action {
     FOLD,
@@ -10,6 +12,12 @@ enum class Action {
     RAISE
 };
 
+// Wire name of an action ("fold", "call", "raise")
+const char* actionName(Action action);
+
+// Action for a wire name, or nullopt if the text is not a known action
+std::optional<Action> parseAction(std::string_view text);
+
 struct BettingState {
     int current_bet; // amount to call
     int min_raise;   // minimum raise amount
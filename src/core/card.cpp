@@ -4,9 +4,6 @@
 
 namespace {
 
-constexpr std::size_t NUM_RANKS = 13;
-constexpr std::size_t NUM_SUITS = 4;
-
 constexpr char rankToChar(Rank rank) noexcept {
     switch (rank) {
         case Rank::TWO: return '2';
@@ -81,33 +78,9 @@ Card::Card(const std::string& str) {
     value_ = static_cast<uint8_t>(rank) * NUM_SUITS + static_cast<uint8_t>(suit);
 }
 
-Card::Card(Rank rank, Suit suit) {
-    value_ = static_cast<uint8_t>(rank) * NUM_SUITS + static_cast<uint8_t>(suit);
-}
-
-Rank Card::rank() const {
-    return static_cast<Rank>(value_ / NUM_SUITS);
-}
-
-Suit Card::suit() const {
-    return static_cast<Suit>(value_ % NUM_SUITS);
-}
-
 std::string Card::toString() const {
     std::string result;
     result += rankToChar(rank());
     result += suitToChar(suit());
     return result;
 }
-
-uint8_t Card::toInt() const {
-    return value_;
-}
-
-bool Card::operator==(const Card& other) const {
-    return value_ == other.value_;
-}
-
-bool Card::operator!=(const Card& other) const {
-    return !(*this == other);
-}
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #include <string>
 #include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
 
 enum class Rank {
     TWO = 0,
@@ -26,20 +30,152 @@ enum class Suit {
     SPADES
 };
 
+constexpr int NUM_RANKS = 13;
+constexpr int NUM_SUITS = 4;
+constexpr int NUM_CARDS = NUM_RANKS * NUM_SUITS;
+
 class Card {
 public:
-    Card() : value_(0) {}
+    constexpr Card() : value_(0) {}
     Card(const std::string& str);
-    Card(Rank rank, Suit suit);
+    constexpr Card(Rank rank, Suit suit)
+        : value_(static_cast<uint8_t>(static_cast<int>(rank) * NUM_SUITS + static_cast<int>(suit))) {}
 
-    Rank rank() const;
-    Suit suit() const;
+    constexpr Rank rank() const { return static_cast<Rank>(value_ / NUM_SUITS); }
+    constexpr Suit suit() const { return static_cast<Suit>(value_ % NUM_SUITS); }
     std::string toString() const;
-    uint8_t toInt() const;
+    constexpr uint8_t toInt() const { return value_; }
 
-    bool operator==(const Card& other) const;
-    bool operator!=(const Card& other) const;
+    constexpr bool operator==(const Card& other) const { return value_ == other.value_; }
+    constexpr bool operator!=(const Card& other) const { return value_ != other.value_; }
 
 private:
     uint8_t value_; // 0-51: rank * 4 + suit
 };
+
+// Set of cards packed into a 64-bit mask. Each suit owns a 16-bit lane with one
+// bit per rank (bit = suit * 16 + rank), so per-suit rank masks, flush and
+// straight checks and dead-card tests are plain bit operations.
+class CardSet {
+public:
+    static constexpr int SUIT_SHIFT = 16;
+    static constexpr uint64_t RANK_LANE_MASK = (1u << NUM_RANKS) - 1;
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Card;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Card*;
+        using reference = Card;
+
+        constexpr iterator() : bits_(0) {}
+        constexpr explicit iterator(uint64_t bits) : bits_(bits) {}
+
+        constexpr Card operator*() const { return CardSet::cardAt(__builtin_ctzll(bits_)); }
+        constexpr iterator& operator++() {
+            bits_ &= bits_ - 1;
+            return *this;
+        }
+        constexpr iterator operator++(int) {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        constexpr bool operator==(const iterator& other) const { return bits_ == other.bits_; }
+        constexpr bool operator!=(const iterator& other) const { return bits_ != other.bits_; }
+
+    private:
+        uint64_t bits_;
+    };
+
+    constexpr CardSet() : bits_(0) {}
+    constexpr explicit CardSet(uint64_t bits) : bits_(bits) {}
+    constexpr explicit CardSet(Card card) : bits_(bitOf(card)) {}
+    constexpr CardSet(std::initializer_list<Card> cards) : bits_(0) {
+        for (Card card : cards) {
+            bits_ |= bitOf(card);
+        }
+    }
+
+    // Build from any container of Card (e.g. Player::hole_cards, Hand::community_cards)
+    template <typename Container, typename = decltype(std::begin(std::declval<const Container&>()))>
+    explicit CardSet(const Container& cards) : bits_(0) {
+        for (const Card& card : cards) {
+            bits_ |= bitOf(card);
+        }
+    }
+
+    static constexpr CardSet fullDeck() {
+        constexpr uint64_t lane = RANK_LANE_MASK;
+        return CardSet(lane | (lane << SUIT_SHIFT) | (lane << (2 * SUIT_SHIFT)) | (lane << (3 * SUIT_SHIFT)));
+    }
+
+    static constexpr uint64_t bitOf(Card card) {
+        return uint64_t{1} << (static_cast<int>(card.suit()) * SUIT_SHIFT + static_cast<int>(card.rank()));
+    }
+
+    static constexpr Card cardAt(int bit) {
+        return Card(static_cast<Rank>(bit % SUIT_SHIFT), static_cast<Suit>(bit / SUIT_SHIFT));
+    }
+
+    constexpr uint64_t bits() const { return bits_; }
+    constexpr int size() const { return __builtin_popcountll(bits_); }
+    constexpr bool empty() const { return bits_ == 0; }
+    constexpr bool contains(Card card) const { return (bits_ & bitOf(card)) != 0; }
+    constexpr bool intersects(CardSet other) const { return (bits_ & other.bits_) != 0; }
+
+    // 13-bit mask of the ranks held in one suit
+    constexpr uint16_t suitMask(Suit suit) const {
+        return static_cast<uint16_t>((bits_ >> (static_cast<int>(suit) * SUIT_SHIFT)) & RANK_LANE_MASK);
+    }
+
+    // 13-bit mask of the ranks held in any suit
+    constexpr uint16_t rankMask() const {
+        return static_cast<uint16_t>((bits_ | (bits_ >> SUIT_SHIFT) | (bits_ >> (2 * SUIT_SHIFT)) |
+                                      (bits_ >> (3 * SUIT_SHIFT))) & RANK_LANE_MASK);
+    }
+
+    constexpr CardSet& add(Card card) {
+        bits_ |= bitOf(card);
+        return *this;
+    }
+    constexpr CardSet& remove(Card card) {
+        bits_ &= ~bitOf(card);
+        return *this;
+    }
+
+    constexpr CardSet operator|(CardSet other) const { return CardSet(bits_ | other.bits_); }
+    constexpr CardSet operator&(CardSet other) const { return CardSet(bits_ & other.bits_); }
+    constexpr CardSet& operator|=(CardSet other) {
+        bits_ |= other.bits_;
+        return *this;
+    }
+    constexpr CardSet& operator&=(CardSet other) {
+        bits_ &= other.bits_;
+        return *this;
+    }
+
+    // Cards in this set that are not in other
+    constexpr CardSet without(CardSet other) const { return CardSet(bits_ & ~other.bits_); }
+
+    // Relabel suits: cards of suit s move to suit perm[s]
+    template <typename Permutation>
+    constexpr CardSet permuteSuits(const Permutation& perm) const {
+        uint64_t permuted = 0;
+        for (int suit = 0; suit < NUM_SUITS; ++suit) {
+            uint64_t lane = (bits_ >> (suit * SUIT_SHIFT)) & RANK_LANE_MASK;
+            permuted |= lane << (static_cast<int>(perm[suit]) * SUIT_SHIFT);
+        }
+        return CardSet(permuted);
+    }
+
+    constexpr bool operator==(CardSet other) const { return bits_ == other.bits_; }
+    constexpr bool operator!=(CardSet other) const { return bits_ != other.bits_; }
+
+    constexpr iterator begin() const { return iterator(bits_); }
+    constexpr iterator end() const { return iterator(0); }
+
+private:
+    uint64_t bits_;
+};
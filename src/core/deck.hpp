@@ -1,18 +1,84 @@
 #pragma once
 
 #include "card.hpp"
-#include <vector>
+#include "rng.hpp"
+#include <array>
 #include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
-class Deck {
+// 52-card deck parameterized on its random bit generator.
+//
+// Shuffling is lazy: shuffle() only rewinds, and each deal() picks a uniform
+// card from the undealt tail and swaps it into place (one Fisher-Yates step).
+// A heads-up hand that deals nine cards does nine steps instead of a full
+// 52-card shuffle, and construction copies a constant card array.
+template <typename Rng>
+class BasicDeck {
 public:
-    Deck();
+    // Seeds the generator from rng::entropySeed() (SystemRandom needs no seed)
+    BasicDeck() : BasicDeck(rng::makeSeeded<Rng>()) {}
+    explicit BasicDeck(Rng generator) : cards_(standardDeck()), next_card_(0), rng_(std::move(generator)) {}
 
-    void shuffle();
-    Card deal();
-    std::size_t size() const;
+    // Deck for stream `stream` (e.g. a hand number) of run `seed`, for
+    // generators seeded by (seed, stream). With a counter-based generator the
+    // deal depends only on the pair, so hands can be replayed or sharded
+    // across threads and processes in any order.
+    template <typename R = Rng, typename = std::enable_if_t<std::is_constructible_v<R, uint64_t, uint64_t>>>
+    static BasicDeck forStream(uint64_t seed, uint64_t stream) {
+        return BasicDeck(Rng(seed, stream));
+    }
+
+    void shuffle() { next_card_ = 0; }
+
+    Card deal() {
+        if (next_card_ >= cards_.size()) {
+            throw std::out_of_range("No cards left in deck");
+        }
+        std::size_t remaining = cards_.size() - next_card_;
+        std::size_t pick = next_card_ + rng::uniformBelow(rng_, static_cast<uint32_t>(remaining));
+        std::swap(cards_[next_card_], cards_[pick]);
+        return cards_[next_card_++];
+    }
+
+    std::size_t size() const { return cards_.size() - next_card_; }
+
+    // Fresh, rewound deck whose generator is seeded from this one. Copying a
+    // deck also copies its generator state, so copies would deal identical
+    // cards; fork() advances this deck's generator instead, keeping seeded runs
+    // reproducible without correlated hands.
+    BasicDeck fork() {
+        if constexpr (std::is_constructible_v<Rng, uint64_t>) {
+            // Separate statements, so the draws happen in the same order on every compiler
+            uint64_t high = static_cast<uint64_t>(rng_());
+            uint64_t low = static_cast<uint64_t>(rng_());
+            uint64_t seed = (high << 32) ^ low;
+            return BasicDeck(Rng(seed));
+        } else {
+            return BasicDeck();
+        }
+    }
 
 private:
-    std::vector<Card> cards_;
+    static constexpr std::array<Card, NUM_CARDS> standardDeck() {
+        std::array<Card, NUM_CARDS> deck{};
+        for (int i = 0; i < NUM_CARDS; ++i) {
+            deck[i] = Card(static_cast<Rank>(i / NUM_SUITS), static_cast<Suit>(i % NUM_SUITS));
+        }
+        return deck;
+    }
+
+    std::array<Card, NUM_CARDS> cards_;
     std::size_t next_card_;
+    Rng rng_;
 };
+
+// Deck used by hands and the server; Deck::forStream(seed, hand) replays a
+// hand. Builds with POKER_SECURE_DECK (CMake option SECURE_DECK) deal from the
+// operating system CSPRNG instead and cannot be replayed.
+#ifdef POKER_SECURE_DECK
+using Deck = BasicDeck<rng::SystemRandom>;
+#else
+using Deck = BasicDeck<rng::Philox4x32>;
+#endif
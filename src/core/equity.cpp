@@ -0,0 +1,381 @@
+#include "equity.hpp"
+#include "hand_evaluator.hpp"
+#include "rng.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+constexpr int HOLE_CARDS = 2;
+constexpr int BOARD_CARDS = 5;
+
+// Work is split into fixed-size tasks so results depend only on the seed, not the pool size
+constexpr uint64_t TRIALS_PER_TASK = 2048;
+constexpr uint64_t TASKS_PER_ROUND = 16;
+
+constexpr double Z_95 = 1.959964;
+
+// Independent stream for one task: scramble (seed, task) so neighbouring tasks do not overlap
+uint64_t streamSeed(uint64_t seed, uint64_t task) {
+    rng::SplitMix64 mixer(seed ^ (task * 0xD1B54A32D192ED03ull));
+    return mixer();
+}
+
+struct Setup {
+    std::vector<CardSet> hole_cards;
+    std::vector<EvaluatorState> known; // each player's hole cards plus the board
+    CardSet board;
+    std::array<uint8_t, NUM_CARDS> deck{}; // bit indices of the cards that can still be dealt
+    int deck_size = 0;
+    int missing = 0; // board cards still to come
+};
+
+struct Tally {
+    explicit Tally(std::size_t players) : wins(players), ties(players), share(players), share_sq(players) {}
+
+    void merge(const Tally& other) {
+        for (std::size_t p = 0; p < wins.size(); ++p) {
+            wins[p] += other.wins[p];
+            ties[p] += other.ties[p];
+            share[p] += other.share[p];
+            share_sq[p] += other.share_sq[p];
+        }
+        trials += other.trials;
+    }
+
+    std::vector<uint64_t> wins;
+    std::vector<uint64_t> ties;
+    std::vector<double> share;
+    std::vector<double> share_sq;
+    uint64_t trials = 0;
+};
+
+// Score every player once the runout completes the board; returns how many share the best hand
+int showdown(const Setup& setup, const EvaluatorState& runout, std::vector<HandStrength>& strengths,
+             HandStrength& best) {
+    int winners = 0;
+    for (std::size_t p = 0; p < setup.known.size(); ++p) {
+        strengths[p] = setup.known[p].with(runout).strength();
+        if (winners == 0 || strengths[p] > best) {
+            best = strengths[p];
+            winners = 1;
+        } else if (strengths[p] == best) {
+            ++winners;
+        }
+    }
+    return winners;
+}
+
+Tally runTrials(const Setup& setup, uint64_t stream, uint64_t trials) {
+    const std::size_t players = setup.hole_cards.size();
+    Tally tally(players);
+    rng::Xoshiro256StarStar generator(stream);
+    std::array<uint8_t, NUM_CARDS> deck = setup.deck;
+    std::vector<HandStrength> strengths(players);
+
+    for (uint64_t t = 0; t < trials; ++t) {
+        // Partial Fisher-Yates: the first `missing` slots become this trial's runout
+        CardSet runout;
+        for (int i = 0; i < setup.missing; ++i) {
+            int j = i + static_cast<int>(rng::uniformBelow(generator, static_cast<uint32_t>(setup.deck_size - i)));
+            std::swap(deck[i], deck[j]);
+            runout |= CardSet(uint64_t{1} << deck[i]);
+        }
+
+        HandStrength best;
+        int winners = showdown(setup, EvaluatorState(runout), strengths, best);
+
+        double share = 1.0 / winners;
+        for (std::size_t p = 0; p < players; ++p) {
+            if (strengths[p] != best) continue;
+            if (winners == 1) {
+                ++tally.wins[p];
+            } else {
+                ++tally.ties[p];
+            }
+            tally.share[p] += share;
+            tally.share_sq[p] += share * share;
+        }
+    }
+    tally.trials = trials;
+    return tally;
+}
+
+using SuitPermutation = std::array<int, NUM_SUITS>;
+
+// Non-identity suit permutations that leave every hand, the board and the dead
+// cards unchanged. Runouts related by one of these have identical outcomes.
+std::vector<SuitPermutation> symmetries(const Setup& setup, CardSet dead) {
+    std::vector<SuitPermutation> result;
+    SuitPermutation perm = {0, 1, 2, 3};
+    while (std::next_permutation(perm.begin(), perm.end())) {
+        bool fixes_all = setup.board.permuteSuits(perm) == setup.board && dead.permuteSuits(perm) == dead;
+        for (CardSet hole : setup.hole_cards) {
+            fixes_all = fixes_all && hole.permuteSuits(perm) == hole;
+        }
+        if (fixes_all) result.push_back(perm);
+    }
+    return result;
+}
+
+// lcm(1..players): pot shares as integers so sums are exact in any order
+uint64_t shareUnits(std::size_t players) {
+    uint64_t units = 1;
+    for (uint64_t k = 2; k <= players; ++k) {
+        uint64_t a = units;
+        uint64_t b = k;
+        while (b != 0) {
+            uint64_t r = a % b;
+            a = b;
+            b = r;
+        }
+        units = units / a * k;
+    }
+    return units;
+}
+
+struct ExactTally {
+    explicit ExactTally(std::size_t players) : wins(players), ties(players), share(players) {}
+
+    void merge(const ExactTally& other) {
+        for (std::size_t p = 0; p < wins.size(); ++p) {
+            wins[p] += other.wins[p];
+            ties[p] += other.ties[p];
+            share[p] += other.share[p];
+        }
+        boards += other.boards;
+    }
+
+    std::vector<uint64_t> wins;  // weighted board counts
+    std::vector<uint64_t> ties;
+    std::vector<uint64_t> share; // in shareUnits per board
+    uint64_t boards = 0;
+};
+
+// Enumerate every runout whose lowest card is setup.deck[first]. Only the
+// lowest-valued runout of each symmetry orbit is scored, weighted by orbit size.
+ExactTally enumerateFrom(const Setup& setup, const std::vector<SuitPermutation>& perms, int first) {
+    const std::size_t players = setup.hole_cards.size();
+    const uint64_t units = shareUnits(players);
+    const uint64_t group_size = perms.size() + 1;
+    const int k = setup.missing;
+    const int n = setup.deck_size;
+    ExactTally tally(players);
+    std::vector<HandStrength> strengths(players);
+    if (first + k > n) return tally;
+
+    // prefix[i] holds the runout cards at idx[0..i], so advancing a position
+    // only re-adds the cards from that position on
+    std::array<int, BOARD_CARDS> idx{};
+    std::array<EvaluatorState, BOARD_CARDS> prefix{};
+    for (int i = 0; i < k; ++i) {
+        idx[i] = first + i;
+        prefix[i] = (i == 0 ? EvaluatorState() : prefix[i - 1]).with(CardSet::cardAt(setup.deck[idx[i]]));
+    }
+
+    while (true) {
+        uint64_t runout = prefix[k - 1].cards().bits();
+
+        bool canonical = true;
+        uint64_t fixed = 1;
+        for (const SuitPermutation& perm : perms) {
+            uint64_t image = CardSet(runout).permuteSuits(perm).bits();
+            if (image < runout) {
+                canonical = false;
+                break;
+            }
+            if (image == runout) ++fixed;
+        }
+
+        if (canonical) {
+            uint64_t weight = group_size / fixed;
+            HandStrength best;
+            int winners = showdown(setup, prefix[k - 1], strengths, best);
+            for (std::size_t p = 0; p < players; ++p) {
+                if (strengths[p] != best) continue;
+                if (winners == 1) {
+                    tally.wins[p] += weight;
+                } else {
+                    tally.ties[p] += weight;
+                }
+                tally.share[p] += weight * (units / winners);
+            }
+            tally.boards += weight;
+        }
+
+        // Next combination with idx[0] held at first
+        int pos = k - 1;
+        while (pos > 0 && idx[pos] == n - k + pos) --pos;
+        if (pos == 0) break;
+        ++idx[pos];
+        for (int i = pos + 1; i < k; ++i) idx[i] = idx[i - 1] + 1;
+        for (int i = pos; i < k; ++i) {
+            prefix[i] = prefix[i - 1].with(CardSet::cardAt(setup.deck[idx[i]]));
+        }
+    }
+    return tally;
+}
+
+Setup prepare(const equity::EquityRequest& request) {
+    if (request.hole_cards.size() < 2) {
+        throw std::invalid_argument("Equity requires at least two players");
+    }
+    if (request.board.size() > BOARD_CARDS) {
+        throw std::invalid_argument("Board cannot hold more than five cards");
+    }
+
+    CardSet used = request.board;
+    if (used.intersects(request.dead)) {
+        throw std::invalid_argument("Dead cards overlap the board");
+    }
+    used |= request.dead;
+    for (CardSet hole : request.hole_cards) {
+        if (hole.size() != HOLE_CARDS) {
+            throw std::invalid_argument("Each player needs exactly two hole cards");
+        }
+        if (used.intersects(hole)) {
+            throw std::invalid_argument("Hole cards overlap other known cards");
+        }
+        used |= hole;
+    }
+
+    Setup setup;
+    setup.hole_cards = request.hole_cards;
+    setup.board = request.board;
+    for (CardSet hole : request.hole_cards) {
+        setup.known.push_back(EvaluatorState(hole | request.board));
+    }
+    setup.missing = BOARD_CARDS - request.board.size();
+    for (Card card : CardSet::fullDeck().without(used)) {
+        setup.deck[setup.deck_size++] = static_cast<uint8_t>(__builtin_ctzll(CardSet::bitOf(card)));
+    }
+    if (setup.deck_size < setup.missing) {
+        throw std::invalid_argument("Not enough cards left to complete the board");
+    }
+    return setup;
+}
+
+} // anonymous namespace
+
+namespace equity {
+
+EquityResult monteCarlo(const EquityRequest& request, ThreadPool& pool) {
+    if (request.max_trials == 0) {
+        throw std::invalid_argument("Equity requires at least one trial");
+    }
+    Setup setup = prepare(request);
+    const std::size_t players = setup.hole_cards.size();
+
+    uint64_t seed = request.seed.has_value()
+        ? *request.seed
+        : (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+
+    Tally total(players);
+    bool converged = false;
+    std::vector<double> std_error(players, 0.0);
+
+    if (setup.missing == 0) {
+        // Board is complete: a single evaluation is exact
+        total = runTrials(setup, seed, 1);
+        converged = true;
+    }
+
+    uint64_t next_task = 0;
+    while (!converged && total.trials < request.max_trials) {
+        std::vector<std::future<Tally>> round;
+        round.reserve(TASKS_PER_ROUND);
+        for (uint64_t i = 0; i < TASKS_PER_ROUND; ++i) {
+            uint64_t queued = total.trials + i * TRIALS_PER_TASK;
+            if (queued >= request.max_trials) break;
+            uint64_t trials = std::min(TRIALS_PER_TASK, request.max_trials - queued);
+            uint64_t stream = streamSeed(seed, next_task++);
+            round.push_back(pool.submit([&setup, stream, trials]() { return runTrials(setup, stream, trials); }));
+        }
+        for (auto& task : round) {
+            total.merge(task.get());
+        }
+
+        double n = static_cast<double>(total.trials);
+        if (total.trials < 2) continue;
+        double worst = 0.0;
+        for (std::size_t p = 0; p < players; ++p) {
+            double mean = total.share[p] / n;
+            double variance = std::max(0.0, (total.share_sq[p] / n - mean * mean) * n / (n - 1.0));
+            std_error[p] = std::sqrt(variance / n);
+            worst = std::max(worst, std_error[p]);
+        }
+        converged = worst <= request.target_std_error;
+    }
+
+    EquityResult result;
+    result.trials = total.trials;
+    result.converged = converged;
+    double n = static_cast<double>(total.trials);
+    for (std::size_t p = 0; p < players; ++p) {
+        PlayerEquity player;
+        player.win = total.wins[p] / n;
+        player.tie = total.ties[p] / n;
+        player.loss = 1.0 - player.win - player.tie;
+        player.equity = total.share[p] / n;
+        player.std_error = std_error[p];
+        player.ci_low = std::max(0.0, player.equity - Z_95 * player.std_error);
+        player.ci_high = std::min(1.0, player.equity + Z_95 * player.std_error);
+        result.players.push_back(player);
+    }
+    return result;
+}
+
+EquityResult enumerate(const EquityRequest& request, ThreadPool& pool) {
+    Setup setup = prepare(request);
+    const std::size_t players = setup.hole_cards.size();
+
+    ExactTally total(players);
+    if (setup.missing == 0) {
+        std::vector<HandStrength> strengths(players);
+        HandStrength best;
+        int winners = showdown(setup, EvaluatorState(), strengths, best);
+        for (std::size_t p = 0; p < players; ++p) {
+            if (strengths[p] != best) continue;
+            if (winners == 1) {
+                total.wins[p] = 1;
+            } else {
+                total.ties[p] = 1;
+            }
+            total.share[p] = shareUnits(players) / winners;
+        }
+        total.boards = 1;
+    } else {
+        // One task per lowest runout card; integer tallies make the merge order irrelevant
+        std::vector<SuitPermutation> perms = symmetries(setup, request.dead);
+        std::vector<std::future<ExactTally>> tasks;
+        tasks.reserve(setup.deck_size);
+        for (int first = 0; first <= setup.deck_size - setup.missing; ++first) {
+            tasks.push_back(pool.submit([&setup, &perms, first]() { return enumerateFrom(setup, perms, first); }));
+        }
+        for (auto& task : tasks) {
+            total.merge(task.get());
+        }
+    }
+
+    EquityResult result;
+    result.trials = total.boards;
+    result.converged = true;
+    double boards = static_cast<double>(total.boards);
+    double units = static_cast<double>(shareUnits(players));
+    for (std::size_t p = 0; p < players; ++p) {
+        PlayerEquity player;
+        player.win = total.wins[p] / boards;
+        player.tie = total.ties[p] / boards;
+        player.loss = static_cast<double>(total.boards - total.wins[p] - total.ties[p]) / boards;
+        player.equity = total.share[p] / (units * boards);
+        player.ci_low = player.equity;
+        player.ci_high = player.equity;
+        result.players.push_back(player);
+    }
+    return result;
+}
+
+} // namespace equity
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "card.hpp"
+#include "thread_pool.hpp"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace equity {
+
+struct EquityRequest {
+    std::vector<CardSet> hole_cards; // two cards per player
+    CardSet board;                   // 0-5 community cards
+    CardSet dead;                    // cards known to be out of play
+    double target_std_error = 0.002; // stop once every player's equity is this precise
+    uint64_t max_trials = 1000000;
+    std::optional<uint64_t> seed;    // fixed seed for reproducible results
+};
+
+struct PlayerEquity {
+    double win = 0.0;       // fraction of runouts won outright
+    double tie = 0.0;       // fraction of runouts split with others
+    double loss = 0.0;
+    double equity = 0.0;    // expected share of the pot
+    double std_error = 0.0; // standard error of equity
+    double ci_low = 0.0;    // 95% confidence interval of equity
+    double ci_high = 0.0;
+};
+
+struct EquityResult {
+    std::vector<PlayerEquity> players;
+    uint64_t trials = 0;    // runouts sampled, or boards enumerated
+    bool converged = false; // target_std_error reached before max_trials
+};
+
+// Estimate all-in equities by sampling board runouts on the pool.
+// Throws std::invalid_argument for fewer than two players, hole cards that are
+// not pairs, boards over five cards, or overlapping hole/board/dead cards.
+EquityResult monteCarlo(const EquityRequest& request, ThreadPool& pool);
+
+// Exact equities from every remaining runout, split across the pool. Runouts
+// that differ only by a suit relabelling that fixes all known cards are scored
+// once and weighted. trials reports the number of boards; seed, max_trials and
+// target_std_error are ignored. Throws like monteCarlo.
+EquityResult enumerate(const EquityRequest& request, ThreadPool& pool);
+
+} // namespace equity
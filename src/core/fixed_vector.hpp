@@ -0,0 +1,95 @@
+#pragma once
+
+#include "span.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+// Vector-like container with inline storage for at most N elements. It never
+// allocates, so hand state built from it can be reset and reused without
+// touching the heap. Growing past N throws std::length_error.
+template <typename T, std::size_t N>
+class FixedVector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    FixedVector() = default;
+    FixedVector(std::initializer_list<T> values) { assign(values); }
+
+    FixedVector& operator=(std::initializer_list<T> values) {
+        assign(values);
+        return *this;
+    }
+
+    void assign(std::initializer_list<T> values) {
+        checkCapacity(values.size());
+        std::copy(values.begin(), values.end(), items_.begin());
+        size_ = values.size();
+    }
+
+    static constexpr size_type capacity() { return N; }
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == N; }
+
+    T& operator[](size_type index) { return items_[index]; }
+    const T& operator[](size_type index) const { return items_[index]; }
+    T& front() { return items_[0]; }
+    const T& front() const { return items_[0]; }
+    T& back() { return items_[size_ - 1]; }
+    const T& back() const { return items_[size_ - 1]; }
+    T* data() { return items_.data(); }
+    const T* data() const { return items_.data(); }
+
+    iterator begin() { return items_.data(); }
+    iterator end() { return items_.data() + size_; }
+    const_iterator begin() const { return items_.data(); }
+    const_iterator end() const { return items_.data() + size_; }
+
+    void push_back(const T& value) {
+        checkCapacity(size_ + 1);
+        items_[size_++] = value;
+    }
+
+    void pop_back() { --size_; }
+
+    void clear() { size_ = 0; }
+
+    void resize(size_type count, const T& value = T()) {
+        checkCapacity(count);
+        for (size_type i = size_; i < count; ++i) items_[i] = value;
+        size_ = count;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        iterator target = begin() + (first - begin());
+        iterator tail = std::move(begin() + (last - begin()), end(), target);
+        size_ = static_cast<size_type>(tail - begin());
+        return target;
+    }
+
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+    operator span<T>() { return span<T>(data(), size_); }
+    operator span<const T>() const { return span<const T>(data(), size_); }
+
+    friend bool operator==(const FixedVector& a, const FixedVector& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+    friend bool operator!=(const FixedVector& a, const FixedVector& b) { return !(a == b); }
+
+private:
+    static void checkCapacity(size_type count) {
+        if (count > N) {
+            throw std::length_error("FixedVector capacity exceeded");
+        }
+    }
+
+    std::array<T, N> items_{};
+    size_type size_ = 0;
+};
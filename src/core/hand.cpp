@@ -1,25 +1,96 @@
 #include "hand.hpp"
 #include "models/player.hpp"
-#include "hand_ranking.hpp"
+#include "hand_evaluator.hpp"
 #include "pot.hpp"
 #include "../common/constants.hpp"
-#include "../common/uuid.hpp"
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <cstdlib>
 #include <chrono>
 
 namespace poker {
 
+uint64_t nextHandId() {
+    static std::atomic<uint64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+
+// Dashes sit where a uuid has them: 8-4-4-4-12 hex digits
+constexpr bool isDash(std::size_t position) {
+    return position == 8 || position == 13 || position == 18 || position == 23;
+}
+
+uint64_t processPrefix() {
+    static const uint64_t prefix = rng::entropySeed();
+    return prefix;
+}
+
+} // anonymous namespace
+
+void writeHandId(uint64_t id, char* out) {
+    constexpr char HEX[] = "0123456789abcdef";
+    uint64_t words[2] = {processPrefix(), id};
+    int digit = 0;
+    for (std::size_t i = 0; i < HAND_ID_LENGTH; ++i) {
+        if (isDash(i)) {
+            out[i] = '-';
+            continue;
+        }
+        uint64_t word = words[digit / 16];
+        out[i] = HEX[(word >> (60 - 4 * (digit % 16))) & 0xF];
+        ++digit;
+    }
+}
+
+std::string formatHandId(uint64_t id) {
+    std::string text(HAND_ID_LENGTH, '\0');
+    writeHandId(id, text.data());
+    return text;
+}
+
+std::optional<uint64_t> parseHandId(std::string_view text) {
+    if (text.size() != HAND_ID_LENGTH) {
+        return std::nullopt;
+    }
+    // Lower-case only, so exactly one spelling maps to each id
+    uint64_t words[2] = {0, 0};
+    int digit = 0;
+    for (std::size_t i = 0; i < HAND_ID_LENGTH; ++i) {
+        char c = text[i];
+        if (isDash(i)) {
+            if (c != '-') {
+                return std::nullopt;
+            }
+            continue;
+        }
+        uint64_t value;
+        if (c >= '0' && c <= '9') {
+            value = static_cast<uint64_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            value = static_cast<uint64_t>(c - 'a' + 10);
+        } else {
+            return std::nullopt;
+        }
+        words[digit / 16] = (words[digit / 16] << 4) | value;
+        ++digit;
+    }
+    if (words[0] != processPrefix() || words[1] == 0) {
+        return std::nullopt;
+    }
+    return words[1];
+}
+
 void startHand(Hand& hand, Deck& deck, Player* dealer, Player* small_blind, Player* big_blind) {
     // Reset hand state
-    hand.id = "hand_" + common::uuid::generate();
+    hand.id = nextHandId();
     hand.table = nullptr; // caller should set
     hand.players = {small_blind, big_blind};
-    hand.player_bets.resize(hand.players.size(), 0);
-    hand.folded.resize(hand.players.size(), false);
-    hand.deck = deck;
-    hand.deck.shuffle();
+    hand.player_bets.assign({0, 0});
+    hand.folded.assign({false, false});
+    hand.deck = deck.fork(); // independent cards per hand even when the caller reuses one deck
     hand.community_cards.clear();
     hand.pot = 0;
     hand.side_pots.clear();
@@ -48,10 +119,14 @@ void dealCommunityCards(Hand& hand, Deck& deck, int count) {
     }
 }
 
-bool applyAction(Hand& hand, Player* player, const std::string& action, int amount) {
+bool applyAction(Hand& hand, Player* player, Action action, int amount) {
     if (!player) {
         return false;
     }
+    // The history buffer is preallocated; refuse actions once it is full
+    if (hand.history.full()) {
+        return false;
+    }
 
     // Ensure folded and player_bets vectors are properly sized
     if (hand.folded.size() != hand.players.size()) {
@@ -62,42 +137,36 @@ bool applyAction(Hand& hand, Player* player, const std::string& action, int amou
     }
 
     // Simplified validation
-    if (action == "fold") {
-        // Mark player folded
-        for (size_t i = 0; i < hand.players.size(); ++i) {
-            if (hand.players[i] == player) {
-                hand.folded[i] = true;
-                break;
+    switch (action) {
+        case Action::FOLD:
+            // Mark player folded
+            for (size_t i = 0; i < hand.players.size(); ++i) {
+                if (hand.players[i] == player) {
+                    hand.folded[i] = true;
+                    break;
+                }
             }
-        }
-    } else if (action == "call") {
-        if (amount > player->stack) return false;
-        if (amount < 0) return false;
-        player->stack -= amount;
-        hand.pot += amount;
-        // Update player's total bet amount
-        for (size_t i = 0; i < hand.players.size(); ++i) {
-            if (hand.players[i] == player) {
-                hand.player_bets[i] += amount;
-                break;
+            break;
+        case Action::CALL:
+        case Action::RAISE:
+            if (action == Action::RAISE && amount < hand.min_raise) return false;
+            if (amount > player->stack) return false;
+            if (amount < 0) return false;
+            player->stack -= amount;
+            hand.pot += amount;
+            // Update player's total bet amount
+            for (size_t i = 0; i < hand.players.size(); ++i) {
+                if (hand.players[i] == player) {
+                    hand.player_bets[i] += amount;
+                    break;
+                }
             }
-        }
-    } else if (action == "raise") {
-        if (amount < hand.min_raise) return false;
-        if (amount > player->stack) return false;
-        if (amount < 0) return false;
-        player->stack -= amount;
-        hand.pot += amount;
-        // Update player's total bet amount
-        for (size_t i = 0; i < hand.players.size(); ++i) {
-            if (hand.players[i] == player) {
-                hand.player_bets[i] += amount;
-                break;
+            if (action == Action::RAISE) {
+                hand.min_raise = amount;
             }
-        }
-        hand.min_raise = amount;
-    } else {
-        return false;
+            break;
+        default:
+            return false;
     }
 
     // Record action history
@@ -157,12 +226,12 @@ bool isHandComplete(const Hand& hand) {
     return active_players <= 1;
 }
 
-std::vector<Player*> determineWinners(const Hand& hand) {
-    std::vector<Player*> winners;
+SeatList determineWinners(const Hand& hand) {
+    SeatList winners;
     if (hand.players.empty()) return winners;
 
     // Count active (non-folded) players
-    std::vector<Player*> active_players;
+    SeatList active_players;
     for (size_t i = 0; i < hand.players.size(); ++i) {
         if (i >= hand.folded.size() || !hand.folded[i]) {
             active_players.push_back(hand.players[i]);
@@ -175,21 +244,23 @@ std::vector<Player*> determineWinners(const Hand& hand) {
         return winners;
     }
 
-    // Evaluate each active player's hand (hole cards + community cards)
-    std::vector<std::pair<Player*, HandRank>> evaluations;
+    // Evaluate each active player's hole cards on top of the shared board; every
+    // player holding the best strength shares the pot
+    EvaluatorState board(CardSet(hand.community_cards));
+    HandStrength best;
     for (auto player : active_players) {
-        // Combine cards
-        std::vector<Card> all_cards = player->hole_cards;
-        all_cards.insert(all_cards.end(), hand.community_cards.begin(), hand.community_cards.end());
-        HandRank rank = HandRanking::evaluate(all_cards);
-        evaluations.emplace_back(player, rank);
-    }
-
-    // Find max rank
-    auto max_it = std::max_element(evaluations.begin(), evaluations.end(),
-        [](const auto& a, const auto& b) { return a.second < b.second; });
-    if (max_it != evaluations.end()) {
-        winners.push_back(max_it->first);
+        CardSet hole(player->hole_cards);
+        if (hole.intersects(board.cards())) {
+            throw std::invalid_argument("Hole cards overlap the board at showdown");
+        }
+        HandStrength strength = EvaluatorState(board).add(hole).strength();
+        if (winners.empty() || strength > best) {
+            winners.clear();
+            best = strength;
+        }
+        if (strength == best) {
+            winners.push_back(player);
+        }
     }
     return winners;
 }
@@ -199,7 +270,7 @@ void calculateSidePots(Hand& hand) {
 }
 
 void resetHand(Hand& hand) {
-    hand.id.clear();
+    hand.id = 0;
     hand.table = nullptr;
     hand.players.clear();
     hand.deck = Deck();
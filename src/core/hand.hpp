@@ -2,11 +2,30 @@
 
 #include "models/hand.hpp"
 #include "deck.hpp"
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace poker {
 
+// Next process-wide hand id (starts at 1; 0 means no hand)
+uint64_t nextHandId();
+
+// Wire form of a hand id, as sent in hand_id message fields: a uuid-shaped
+// string whose first 64 bits are random per process and whose last 64 are the
+// id, so ids from different runs or processes never collide
+constexpr std::size_t HAND_ID_LENGTH = 36;
+std::string formatHandId(uint64_t id);
+
+// formatHandId without the string; out must hold HAND_ID_LENGTH chars
+void writeHandId(uint64_t id, char* out);
+
+// Inverse of formatHandId; nullopt unless text is the wire form of a nonzero id
+// issued by this process
+std::optional<uint64_t> parseHandId(std::string_view text);
+
 // Initialize a new hand: shuffle deck, assign dealer, set blinds, deal hole cards
 void startHand(Hand& hand, Deck& deck, Player* dealer, Player* small_blind, Player* big_blind);
 
@@ -17,7 +36,7 @@ void dealHoleCards(Hand& hand, Deck& deck);
 void dealCommunityCards(Hand& hand, Deck& deck, int count);
 
 // Apply a player action (fold, call, raise) and update hand state
-bool applyAction(Hand& hand, Player* player, const std::string& action, int amount);
+bool applyAction(Hand& hand, Player* player, Action action, int amount);
 
 // Advance to the next betting round (preflop -> flop -> turn -> river -> showdown)
 bool advanceBettingRound(Hand& hand);
@@ -26,7 +45,7 @@ bool advanceBettingRound(Hand& hand);
 bool isHandComplete(const Hand& hand);
 
 // Determine winner(s) of the hand (multiple players can split pot)
-std::vector<Player*> determineWinners(const Hand& hand);
+SeatList determineWinners(const Hand& hand);
 
 // Calculate side pots based on all-in situations
 void calculateSidePots(Hand& hand);
@@ -0,0 +1,425 @@
+#include "hand_evaluator.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAND_EVALUATOR_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr int MIN_CARDS = 5;
+constexpr int MAX_CARDS = 7;
+constexpr int MAX_PER_RANK = 4;
+
+// Number of rank-count vectors of a given length (entries 0-4) summing to a given total
+using CountTable = std::array<std::array<uint32_t, MAX_CARDS + 1>, NUM_RANKS + 1>;
+
+constexpr CountTable buildCountTable() {
+    CountTable n{};
+    n[0][0] = 1;
+    for (int len = 1; len <= NUM_RANKS; ++len) {
+        for (int sum = 0; sum <= MAX_CARDS; ++sum) {
+            for (int v = 0; v <= MAX_PER_RANK && v <= sum; ++v) {
+                n[len][sum] += n[len - 1][sum - v];
+            }
+        }
+    }
+    return n;
+}
+
+constexpr CountTable RANK_VECTOR_COUNT = buildCountTable();
+
+// Perfect hash offsets for rank-count vectors. Ranks are consumed from ace down
+// to two; offset[rank][remaining][count] is the number of vectors with the same
+// prefix that sort before this one, which makes the hash dense and minimal for
+// each card total.
+using OffsetTable = std::array<std::array<std::array<uint16_t, MAX_PER_RANK + 1>, MAX_CARDS + 1>, NUM_RANKS>;
+
+constexpr OffsetTable buildOffsetTable() {
+    OffsetTable off{};
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        for (int remaining = 0; remaining <= MAX_CARDS; ++remaining) {
+            uint32_t acc = 0;
+            for (int q = 0; q <= MAX_PER_RANK; ++q) {
+                off[rank][remaining][q] = static_cast<uint16_t>(acc);
+                if (q <= remaining) {
+                    acc += RANK_VECTOR_COUNT[rank][remaining - q];
+                }
+            }
+        }
+    }
+    return off;
+}
+
+constexpr OffsetTable RANK_HASH_OFFSET = buildOffsetTable();
+
+constexpr uint32_t noFlushTableBase(int cards) {
+    uint32_t base = 0;
+    for (int n = MIN_CARDS; n < cards; ++n) {
+        base += RANK_VECTOR_COUNT[NUM_RANKS][n];
+    }
+    return base;
+}
+
+// RANK_HASH_OFFSET widened and flattened to [rank][remaining][count] for 32-bit gathers
+constexpr int OFFSET_ROW = (MAX_CARDS + 1) * (MAX_PER_RANK + 1);
+using FlatOffsetTable = std::array<int32_t, NUM_RANKS * OFFSET_ROW>;
+
+constexpr FlatOffsetTable buildFlatOffsetTable() {
+    FlatOffsetTable flat{};
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        for (int remaining = 0; remaining <= MAX_CARDS; ++remaining) {
+            for (int q = 0; q <= MAX_PER_RANK; ++q) {
+                flat[rank * OFFSET_ROW + remaining * (MAX_PER_RANK + 1) + q] = RANK_HASH_OFFSET[rank][remaining][q];
+            }
+        }
+    }
+    return flat;
+}
+
+constexpr FlatOffsetTable RANK_HASH_OFFSET_FLAT = buildFlatOffsetTable();
+
+constexpr uint32_t NO_FLUSH_TABLE_SIZE = noFlushTableBase(MAX_CARDS + 1);
+constexpr uint32_t FLUSH_TABLE_SIZE = 1u << NUM_RANKS;
+
+// Perfect hash of rank counts packed four bits per rank (rank r in bits 4r..4r+3)
+uint32_t hashPackedRankCounts(uint64_t packed, int total) noexcept {
+    uint32_t hash = 0;
+    int remaining = total;
+    for (int rank = NUM_RANKS - 1; rank >= 0 && remaining > 0; --rank) {
+        int count = static_cast<int>((packed >> (4 * rank)) & 0xF);
+        hash += RANK_HASH_OFFSET[rank][remaining][count];
+        remaining -= count;
+    }
+    return hash;
+}
+
+// Highest card of the best straight in a rank mask, or -1 (wheel reports the five)
+int straightHigh(uint32_t mask) noexcept {
+    constexpr uint32_t FIVE_IN_A_ROW = 0x1F;
+    for (int high = NUM_RANKS - 1; high >= 4; --high) {
+        uint32_t window = FIVE_IN_A_ROW << (high - 4);
+        if ((mask & window) == window) {
+            return high;
+        }
+    }
+    constexpr uint32_t WHEEL = (1u << 12) | 0xF; // A, 2, 3, 4, 5
+    if ((mask & WHEEL) == WHEEL) {
+        return 3;
+    }
+    return -1;
+}
+
+// Sortable key used only while building the tables: category in bits 20+ and
+// up to five 4-bit tiebreak ranks below it, most significant first.
+constexpr int RAW_CATEGORY_SHIFT = 20;
+
+uint32_t makeRawKey(HandRank rank, const std::vector<int>& tiebreaks) {
+    uint32_t key = 0;
+    for (int r : tiebreaks) {
+        key = (key << 4) | static_cast<uint32_t>(r);
+    }
+    return (static_cast<uint32_t>(rank) << RAW_CATEGORY_SHIFT) | key;
+}
+
+// Append the highest ranks present in mask (skipping excluded ranks) until out holds n entries
+void takeHighest(uint32_t mask, uint32_t exclude, int n, std::vector<int>& out) {
+    for (int rank = NUM_RANKS - 1; rank >= 0 && static_cast<int>(out.size()) < n; --rank) {
+        if ((mask & (1u << rank)) && !(exclude & (1u << rank))) {
+            out.push_back(rank);
+        }
+    }
+}
+
+// Best non-flush 5-card hand from rank counts of 5-7 cards
+uint32_t bestRawKey(const uint8_t* counts) {
+    uint32_t present = 0;
+    int quads = -1;
+    std::vector<int> trips;
+    std::vector<int> pairs;
+    for (int rank = NUM_RANKS - 1; rank >= 0; --rank) {
+        if (counts[rank] > 0) present |= 1u << rank;
+        if (counts[rank] == 4 && quads < 0) quads = rank;
+        if (counts[rank] == 3) trips.push_back(rank);
+        if (counts[rank] == 2) pairs.push_back(rank);
+    }
+
+    std::vector<int> kickers;
+    if (quads >= 0) {
+        takeHighest(present, 1u << quads, 1, kickers);
+        return makeRawKey(HandRank::FOUR_OF_A_KIND, {quads, kickers[0]});
+    }
+    if (!trips.empty() && (trips.size() >= 2 || !pairs.empty())) {
+        int pair = trips.size() >= 2 ? trips[1] : -1;
+        if (!pairs.empty()) pair = std::max(pair, pairs[0]);
+        return makeRawKey(HandRank::FULL_HOUSE, {trips[0], pair});
+    }
+    int straight = straightHigh(present);
+    if (straight >= 0) {
+        return makeRawKey(HandRank::STRAIGHT, {straight});
+    }
+    if (!trips.empty()) {
+        kickers.push_back(trips[0]);
+        takeHighest(present, 1u << trips[0], 3, kickers);
+        return makeRawKey(HandRank::THREE_OF_A_KIND, kickers);
+    }
+    if (pairs.size() >= 2) {
+        kickers.push_back(pairs[0]);
+        kickers.push_back(pairs[1]);
+        takeHighest(present, (1u << pairs[0]) | (1u << pairs[1]), 3, kickers);
+        return makeRawKey(HandRank::TWO_PAIR, kickers);
+    }
+    if (pairs.size() == 1) {
+        kickers.push_back(pairs[0]);
+        takeHighest(present, 1u << pairs[0], 4, kickers);
+        return makeRawKey(HandRank::ONE_PAIR, kickers);
+    }
+    takeHighest(present, 0, 5, kickers);
+    return makeRawKey(HandRank::HIGH_CARD, kickers);
+}
+
+// Best flush from the rank mask of a single suit holding at least five cards
+uint32_t flushRawKey(uint32_t mask) {
+    int straight = straightHigh(mask);
+    if (straight == NUM_RANKS - 1) {
+        return makeRawKey(HandRank::ROYAL_FLUSH, {});
+    }
+    if (straight >= 0) {
+        return makeRawKey(HandRank::STRAIGHT_FLUSH, {straight});
+    }
+    std::vector<int> kickers;
+    takeHighest(mask, 0, 5, kickers);
+    return makeRawKey(HandRank::FLUSH, kickers);
+}
+
+int popcount(uint32_t x) noexcept {
+    return __builtin_popcount(x);
+}
+
+struct Tables {
+    std::array<uint16_t, NO_FLUSH_TABLE_SIZE> no_flush{};
+    std::array<uint16_t, FLUSH_TABLE_SIZE> flush{};
+    // Rank mask spread to one count nibble per rank; summing the four suit lanes gives packed rank counts
+    std::array<uint64_t, FLUSH_TABLE_SIZE> rank_spread{};
+
+    Tables() {
+        // Collect every distinct 5-card hand class and order them
+        std::vector<uint32_t> raw_keys;
+        raw_keys.reserve(HandEvaluator::NUM_DISTINCT_HANDS);
+        std::array<uint8_t, NUM_RANKS> counts{};
+        forEachRankVector(counts, NUM_RANKS - 1, MIN_CARDS,
+            [&raw_keys](const uint8_t* c) { raw_keys.push_back(bestRawKey(c)); });
+        for (uint32_t mask = 0; mask < FLUSH_TABLE_SIZE; ++mask) {
+            if (popcount(mask) == MIN_CARDS) {
+                raw_keys.push_back(flushRawKey(mask));
+            }
+        }
+        std::sort(raw_keys.begin(), raw_keys.end());
+        raw_keys.erase(std::unique(raw_keys.begin(), raw_keys.end()), raw_keys.end());
+
+        auto toStrength = [&raw_keys](uint32_t raw) {
+            uint32_t category = raw >> RAW_CATEGORY_SHIFT;
+            auto first = std::lower_bound(raw_keys.begin(), raw_keys.end(), category << RAW_CATEGORY_SHIFT);
+            auto it = std::lower_bound(first, raw_keys.end(), raw);
+            return static_cast<uint16_t>((category << HandStrength::CATEGORY_SHIFT) | (it - first));
+        };
+
+        for (int cards = MIN_CARDS; cards <= MAX_CARDS; ++cards) {
+            uint32_t base = noFlushTableBase(cards);
+            forEachRankVector(counts, NUM_RANKS - 1, cards,
+                [this, base, cards, &toStrength](const uint8_t* c) {
+                    uint64_t packed = 0;
+                    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+                        packed |= static_cast<uint64_t>(c[rank]) << (4 * rank);
+                    }
+                    no_flush[base + hashPackedRankCounts(packed, cards)] = toStrength(bestRawKey(c));
+                });
+        }
+        for (uint32_t mask = 0; mask < FLUSH_TABLE_SIZE; ++mask) {
+            if (popcount(mask) >= MIN_CARDS) {
+                flush[mask] = toStrength(flushRawKey(mask));
+            }
+            for (int rank = 0; rank < NUM_RANKS; ++rank) {
+                if (mask & (1u << rank)) {
+                    rank_spread[mask] |= uint64_t{1} << (4 * rank);
+                }
+            }
+        }
+    }
+
+    template <typename Fn>
+    static void forEachRankVector(std::array<uint8_t, NUM_RANKS>& counts, int rank, int remaining, Fn&& fn) {
+        if (rank < 0) {
+            if (remaining == 0) fn(counts.data());
+            return;
+        }
+        for (int q = 0; q <= MAX_PER_RANK && q <= remaining; ++q) {
+            counts[rank] = static_cast<uint8_t>(q);
+            forEachRankVector(counts, rank - 1, remaining - q, fn);
+        }
+        counts[rank] = 0;
+    }
+};
+
+const Tables& tables() {
+    static const Tables instance;
+    return instance;
+}
+
+int checkedSize(CardSet cards) {
+    int total = cards.size();
+    if (total < MIN_CARDS || total > MAX_CARDS) {
+        throw std::invalid_argument("Hand evaluation requires 5-7 cards");
+    }
+    return total;
+}
+
+// Flush strength if a suit holds five or more cards (flush strengths are never
+// zero), otherwise the packed rank counts to hash
+struct Lookup {
+    uint16_t flush;
+    uint64_t packed;
+};
+
+Lookup lookup(const Tables& t, CardSet cards) noexcept {
+    std::array<uint32_t, NUM_SUITS> suit_masks{};
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        suit_masks[suit] = cards.suitMask(static_cast<Suit>(suit));
+        if (popcount(suit_masks[suit]) >= MIN_CARDS) {
+            return {t.flush[suit_masks[suit]], 0};
+        }
+    }
+    return {0, t.rank_spread[suit_masks[0]] + t.rank_spread[suit_masks[1]] +
+                   t.rank_spread[suit_masks[2]] + t.rank_spread[suit_masks[3]]};
+}
+
+#ifdef HAND_EVALUATOR_AVX2
+
+// Eight hands per iteration: the flush check and rank-count packing stay
+// scalar, the thirteen dependent steps of the perfect hash run as 32-bit
+// gathers across lanes. Packed counts are split into ranks 0-7 and 8-12.
+__attribute__((target("avx2")))
+void evaluateBatchAvx2(const CardSet* hands, HandStrength* results, std::size_t count) {
+    constexpr int LANES = 8;
+    constexpr int LOW_RANKS = 8;
+    const Tables& t = tables();
+    const __m256i nibble = _mm256_set1_epi32(0xF);
+    const __m256i row_stride = _mm256_set1_epi32(MAX_PER_RANK + 1);
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        alignas(32) int32_t low[LANES];
+        alignas(32) int32_t high[LANES];
+        alignas(32) int32_t remaining[LANES];
+        alignas(32) int32_t hash[LANES];
+        int total[LANES];
+        uint16_t flush[LANES];
+        for (int lane = 0; lane < LANES; ++lane) {
+            total[lane] = checkedSize(hands[i + lane]);
+            Lookup l = lookup(t, hands[i + lane]);
+            flush[lane] = l.flush;
+            remaining[lane] = l.flush != 0 ? 0 : total[lane];
+            low[lane] = static_cast<int32_t>(l.packed & 0xFFFFFFFFu);
+            high[lane] = static_cast<int32_t>(l.packed >> 32);
+        }
+
+        __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(low));
+        __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(high));
+        __m256i rem = _mm256_load_si256(reinterpret_cast<const __m256i*>(remaining));
+        __m256i h = _mm256_setzero_si256();
+        for (int rank = NUM_RANKS - 1; rank >= 0; --rank) {
+            __m256i source = rank >= LOW_RANKS ? hi : lo;
+            __m256i shift = _mm256_set1_epi32(4 * (rank % LOW_RANKS));
+            __m256i counts = _mm256_and_si256(_mm256_srlv_epi32(source, shift), nibble);
+            __m256i index = _mm256_add_epi32(_mm256_set1_epi32(rank * OFFSET_ROW),
+                                             _mm256_add_epi32(_mm256_mullo_epi32(rem, row_stride), counts));
+            h = _mm256_add_epi32(h, _mm256_i32gather_epi32(RANK_HASH_OFFSET_FLAT.data(), index, 4));
+            rem = _mm256_sub_epi32(rem, counts);
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(hash), h);
+
+        for (int lane = 0; lane < LANES; ++lane) {
+            results[i + lane] = HandStrength(flush[lane] != 0
+                ? flush[lane]
+                : t.no_flush[noFlushTableBase(total[lane]) + static_cast<uint32_t>(hash[lane])]);
+        }
+    }
+    for (; i < count; ++i) {
+        results[i] = HandEvaluator::evaluate(hands[i]);
+    }
+}
+
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#endif // HAND_EVALUATOR_AVX2
+
+} // anonymous namespace
+
+HandStrength HandEvaluator::evaluate(const Card* cards, std::size_t count) {
+    CardSet set;
+    for (std::size_t i = 0; i < count; ++i) {
+        set.add(cards[i]);
+    }
+    if (static_cast<std::size_t>(set.size()) != count) {
+        throw std::invalid_argument("Duplicate card in hand");
+    }
+    return evaluate(set);
+}
+
+HandStrength HandEvaluator::evaluate(CardSet cards) {
+    int total = checkedSize(cards);
+    const Tables& t = tables();
+    Lookup l = lookup(t, cards);
+    if (l.flush != 0) {
+        return HandStrength(l.flush);
+    }
+    return HandStrength(t.no_flush[noFlushTableBase(total) + hashPackedRankCounts(l.packed, total)]);
+}
+
+HandStrength HandEvaluator::evaluate(const EvaluatorState& state) {
+    CardSet cards = state.cards();
+    int total = checkedSize(cards);
+    const Tables& t = tables();
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        uint32_t mask = cards.suitMask(static_cast<Suit>(suit));
+        if (popcount(mask) >= MIN_CARDS) {
+            return HandStrength(t.flush[mask]);
+        }
+    }
+    return HandStrength(t.no_flush[noFlushTableBase(total) + hashPackedRankCounts(state.rankCounts(), total)]);
+}
+
+void EvaluatorState::throwDuplicate() {
+    throw std::invalid_argument("Card already in hand");
+}
+
+EvaluatorState& EvaluatorState::add(CardSet cards) {
+    if (cards_.intersects(cards)) {
+        throwDuplicate();
+    }
+    const Tables& t = tables();
+    cards_ |= cards;
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        rank_counts_ += t.rank_spread[cards.suitMask(static_cast<Suit>(suit))];
+    }
+    return *this;
+}
+
+void HandEvaluator::evaluateBatch(const CardSet* hands, HandStrength* results, std::size_t count) {
+#ifdef HAND_EVALUATOR_AVX2
+    if (cpuHasAvx2()) {
+        evaluateBatchAvx2(hands, results, count);
+        return;
+    }
+#endif
+    for (std::size_t i = 0; i < count; ++i) {
+        results[i] = evaluate(hands[i]);
+    }
+}
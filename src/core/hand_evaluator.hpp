@@ -0,0 +1,75 @@
+#pragma once
+
+#include "card.hpp"
+#include "hand_ranking.hpp"
+#include <cstddef>
+#include <cstdint>
+
+class EvaluatorState;
+
+// Table-driven evaluator for 5, 6 or 7 cards.
+//
+// Returns the HandStrength of the best 5-card hand. Evaluation performs no heap
+// allocation; the lookup tables are built once on first use.
+class HandEvaluator {
+public:
+    // Number of distinct 5-card hand strengths
+    static constexpr int NUM_DISTINCT_HANDS = 7462;
+
+    // Evaluate 5-7 cards. Throws std::invalid_argument for other counts or duplicate cards.
+    static HandStrength evaluate(const Card* cards, std::size_t count);
+
+    // Evaluate a set of 5-7 cards. Throws std::invalid_argument for other sizes.
+    static HandStrength evaluate(CardSet cards);
+
+    // Evaluate a state holding 5-7 cards. Throws std::invalid_argument for other sizes.
+    static HandStrength evaluate(const EvaluatorState& state);
+
+    // Evaluate count sets of 5-7 cards into results. Dispatches at runtime to an
+    // AVX2 path that hashes eight hands at a time; results are identical to evaluate().
+    static void evaluateBatch(const CardSet* hands, HandStrength* results, std::size_t count);
+};
+
+// Partial hand that grows one card (or one street) at a time.
+//
+// Keeps the cards as a CardSet, whose lanes are the suit masks, and the rank
+// counts packed four bits per rank, which is the additive key the rank hash
+// consumes. Both update in O(1) per card and the state is 16 trivially
+// copyable bytes, so walks over flop, turn and river copy the shared prefix
+// instead of rebuilding it.
+class EvaluatorState {
+public:
+    constexpr EvaluatorState() : cards_(), rank_counts_(0) {}
+    explicit EvaluatorState(CardSet cards) : EvaluatorState() { add(cards); }
+
+    // Each add throws std::invalid_argument if a card is already held
+    EvaluatorState& add(Card card) {
+        if (cards_.contains(card)) throwDuplicate();
+        cards_.add(card);
+        rank_counts_ += uint64_t{1} << (4 * static_cast<int>(card.rank()));
+        return *this;
+    }
+    EvaluatorState& add(CardSet cards);
+    EvaluatorState& add(const EvaluatorState& other) {
+        if (cards_.intersects(other.cards_)) throwDuplicate();
+        cards_ |= other.cards_;
+        rank_counts_ += other.rank_counts_;
+        return *this;
+    }
+
+    EvaluatorState with(Card card) const { return EvaluatorState(*this).add(card); }
+    EvaluatorState with(const EvaluatorState& other) const { return EvaluatorState(*this).add(other); }
+
+    CardSet cards() const { return cards_; }
+    int size() const { return cards_.size(); }
+    uint64_t rankCounts() const { return rank_counts_; }
+
+    // Best 5-card hand; requires 5-7 cards
+    HandStrength strength() const { return HandEvaluator::evaluate(*this); }
+
+private:
+    [[noreturn]] static void throwDuplicate();
+
+    CardSet cards_;
+    uint64_t rank_counts_; // rank r count in bits 4r..4r+3
+};
@@ -0,0 +1,219 @@
+#include "hand_indexer.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace {
+
+uint64_t choose(uint64_t n, int k) {
+    if (k < 0 || static_cast<uint64_t>(k) > n) return 0;
+    uint64_t result = 1;
+    for (int i = 0; i < k; ++i) {
+        result = result * (n - i) / (i + 1);
+    }
+    return result;
+}
+
+// Colex rank of a subset of [0, 13): sum of C(element, position)
+uint64_t colexIndex(uint32_t mask) {
+    uint64_t index = 0;
+    int position = 1;
+    for (; mask != 0; mask &= mask - 1) {
+        index += choose(__builtin_ctz(mask), position++);
+    }
+    return index;
+}
+
+uint32_t colexSubset(uint64_t index, int size) {
+    uint32_t mask = 0;
+    for (int position = size; position >= 1; --position) {
+        int element = position - 1;
+        while (choose(element + 1, position) <= index) ++element;
+        mask |= 1u << element;
+        index -= choose(element, position);
+    }
+    return mask;
+}
+
+// Renumber the ranks in `ranks` by their position among the ranks not in `taken`
+uint32_t compressRanks(uint32_t ranks, uint32_t taken) {
+    uint32_t compressed = 0;
+    for (; ranks != 0; ranks &= ranks - 1) {
+        int rank = __builtin_ctz(ranks);
+        compressed |= 1u << (rank - __builtin_popcount(taken & ((1u << rank) - 1)));
+    }
+    return compressed;
+}
+
+uint32_t expandRanks(uint32_t compressed, uint32_t taken) {
+    uint32_t ranks = 0;
+    int free_position = 0;
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        if (taken & (1u << rank)) continue;
+        if (compressed & (1u << free_position)) ranks |= 1u << rank;
+        ++free_position;
+    }
+    return ranks;
+}
+
+// Index of a non-increasing multiset of k values: sum of C(a_i + k - i, k - i + 1)
+uint64_t multisetIndex(const uint64_t* values, int k) {
+    uint64_t index = 0;
+    for (int i = 0; i < k; ++i) {
+        index += choose(values[i] + (k - 1 - i), k - i);
+    }
+    return index;
+}
+
+void multisetValues(uint64_t index, int k, uint64_t range, uint64_t* values) {
+    for (int i = 0; i < k; ++i) {
+        int size = k - i;
+        // Largest v with C(v, size) <= index
+        uint64_t low = size - 1;
+        uint64_t high = range + k - 1;
+        while (low < high) {
+            uint64_t mid = (low + high + 1) / 2;
+            if (choose(mid, size) <= index) {
+                low = mid;
+            } else {
+                high = mid - 1;
+            }
+        }
+        index -= choose(low, size);
+        values[i] = low - (k - 1 - i);
+    }
+}
+
+} // anonymous namespace
+
+HandIndexer::HandIndexer(int board_cards) : board_cards_(board_cards) {
+    if (board_cards != 0 && (board_cards < 3 || board_cards > 5)) {
+        throw std::invalid_argument("Board must have 0, 3, 4 or 5 cards");
+    }
+    int base = (HOLE_CARDS + 1) * (board_cards_ + 1);
+    configuration_by_key_.assign(static_cast<std::size_t>(base * base * base * base), -1);
+    std::vector<SuitCounts> counts;
+    addConfigurations(counts, HOLE_CARDS, board_cards_);
+}
+
+int HandIndexer::configurationKey(const SuitCounts* sorted) const {
+    int base = (HOLE_CARDS + 1) * (board_cards_ + 1);
+    int key = 0;
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        key = key * base + sorted[suit].hole * (board_cards_ + 1) + sorted[suit].board;
+    }
+    return key;
+}
+
+// Enumerate per-suit counts in non-increasing order, one configuration per multiset
+void HandIndexer::addConfigurations(std::vector<SuitCounts>& counts, int hole_left, int board_left) {
+    if (static_cast<int>(counts.size()) == NUM_SUITS) {
+        if (hole_left != 0 || board_left != 0) return;
+
+        Configuration config;
+        config.offset = size_;
+        config.size = 1;
+        for (int suit = 0; suit < NUM_SUITS; ++suit) {
+            if (!config.groups.empty() && config.groups.back().counts == counts[suit]) {
+                ++config.groups.back().suits;
+                continue;
+            }
+            SuitGroup group;
+            group.counts = counts[suit];
+            group.suits = 1;
+            group.suit_range = choose(NUM_RANKS, counts[suit].hole) *
+                               choose(NUM_RANKS - counts[suit].hole, counts[suit].board);
+            config.groups.push_back(group);
+        }
+        for (SuitGroup& group : config.groups) {
+            group.group_range = choose(group.suit_range + group.suits - 1, group.suits);
+            config.size *= group.group_range;
+        }
+        configuration_by_key_[configurationKey(counts.data())] = static_cast<int>(configurations_.size());
+        configurations_.push_back(config);
+        size_ += config.size;
+        return;
+    }
+
+    for (int hole = std::min(hole_left, NUM_RANKS); hole >= 0; --hole) {
+        for (int board = std::min(board_left, NUM_RANKS - hole); board >= 0; --board) {
+            SuitCounts next{hole, board};
+            if (!counts.empty() && next > counts.back()) continue;
+            counts.push_back(next);
+            addConfigurations(counts, hole_left - hole, board_left - board);
+            counts.pop_back();
+        }
+    }
+}
+
+uint64_t HandIndexer::index(CardSet hole, CardSet board) const {
+    if (hole.size() != HOLE_CARDS || board.size() != board_cards_) {
+        throw std::invalid_argument("Wrong number of cards for this street");
+    }
+    if (hole.intersects(board)) {
+        throw std::invalid_argument("Hole cards overlap the board");
+    }
+
+    struct SuitEntry {
+        SuitCounts counts;
+        uint64_t index;
+    };
+    std::array<SuitEntry, NUM_SUITS> suits;
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        uint32_t hole_ranks = hole.suitMask(static_cast<Suit>(suit));
+        uint32_t board_ranks = board.suitMask(static_cast<Suit>(suit));
+        int hole_count = __builtin_popcount(hole_ranks);
+        suits[suit].counts = {hole_count, __builtin_popcount(board_ranks)};
+        suits[suit].index = colexIndex(hole_ranks) +
+                            choose(NUM_RANKS, hole_count) * colexIndex(compressRanks(board_ranks, hole_ranks));
+    }
+    std::sort(suits.begin(), suits.end(), [](const SuitEntry& a, const SuitEntry& b) {
+        return a.counts == b.counts ? a.index > b.index : a.counts > b.counts;
+    });
+
+    std::array<SuitCounts, NUM_SUITS> sorted;
+    std::array<uint64_t, NUM_SUITS> indices;
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        sorted[suit] = suits[suit].counts;
+        indices[suit] = suits[suit].index;
+    }
+    const Configuration& config = configurations_[configuration_by_key_[configurationKey(sorted.data())]];
+
+    uint64_t result = 0;
+    uint64_t multiplier = 1;
+    int first = 0;
+    for (const SuitGroup& group : config.groups) {
+        result += multiplier * multisetIndex(indices.data() + first, group.suits);
+        multiplier *= group.group_range;
+        first += group.suits;
+    }
+    return config.offset + result;
+}
+
+std::pair<CardSet, CardSet> HandIndexer::unindex(uint64_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("Hand index out of range");
+    }
+    auto it = std::upper_bound(configurations_.begin(), configurations_.end(), index,
+                               [](uint64_t value, const Configuration& config) { return value < config.offset; });
+    const Configuration& config = *(it - 1);
+
+    uint64_t remaining = index - config.offset;
+    uint64_t hole_bits = 0;
+    uint64_t board_bits = 0;
+    int suit = 0;
+    for (const SuitGroup& group : config.groups) {
+        std::array<uint64_t, NUM_SUITS> values;
+        multisetValues(remaining % group.group_range, group.suits, group.suit_range, values.data());
+        remaining /= group.group_range;
+
+        uint64_t hole_range = choose(NUM_RANKS, group.counts.hole);
+        for (int i = 0; i < group.suits; ++i, ++suit) {
+            uint32_t hole_ranks = colexSubset(values[i] % hole_range, group.counts.hole);
+            uint32_t board_ranks = expandRanks(colexSubset(values[i] / hole_range, group.counts.board), hole_ranks);
+            hole_bits |= static_cast<uint64_t>(hole_ranks) << (suit * CardSet::SUIT_SHIFT);
+            board_bits |= static_cast<uint64_t>(board_ranks) << (suit * CardSet::SUIT_SHIFT);
+        }
+    }
+    return {CardSet(hole_bits), CardSet(board_bits)};
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "card.hpp"
+#include "span.hpp"
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -17,11 +19,44 @@ enum class HandRank {
     ROYAL_FLUSH
 };
 
+// Single comparable hand value: the HandRank category in the top 4 bits and the
+// kicker ordinal within that category below it. A larger value is a better hand
+// and equal values are exact ties.
+class HandStrength {
+public:
+    static constexpr int CATEGORY_SHIFT = 12;
+
+    constexpr HandStrength() : value_(0) {}
+    constexpr explicit HandStrength(uint16_t value) : value_(value) {}
+
+    constexpr uint16_t value() const { return value_; }
+    constexpr HandRank rank() const { return static_cast<HandRank>(value_ >> CATEGORY_SHIFT); }
+
+    constexpr bool operator==(HandStrength other) const { return value_ == other.value_; }
+    constexpr bool operator!=(HandStrength other) const { return value_ != other.value_; }
+    constexpr bool operator<(HandStrength other) const { return value_ < other.value_; }
+    constexpr bool operator<=(HandStrength other) const { return value_ <= other.value_; }
+    constexpr bool operator>(HandStrength other) const { return value_ > other.value_; }
+    constexpr bool operator>=(HandStrength other) const { return value_ >= other.value_; }
+
+private:
+    uint16_t value_;
+};
+
 class HandRanking {
 public:
     static HandRank evaluate(const std::vector<Card>& cards);
     static std::string rankToString(HandRank rank) noexcept;
 
-    // For comparing two hands of same rank
+    // Full strength (category plus kickers) of the best 5-card hand in 5-7 cards
+    static HandStrength strength(const std::vector<Card>& cards);
+    static HandStrength strength(CardSet cards);
+
+    // Evaluate many 5-7 card hands in one call; results[i] is strength(hands[i]).
+    // Uses AVX2 when the CPU supports it. Throws std::invalid_argument if the
+    // spans differ in length or a hand has the wrong number of cards.
+    static void evaluateBatch(span<const CardSet> hands, span<HandStrength> results);
+
+    // Compare two hands: positive if hand1 is better, negative if hand2 is better, 0 on a tie
     static int compare(const std::vector<Card>& hand1, const std::vector<Card>& hand2);
 };
@@ -2,8 +2,10 @@
 
 #include "../card.hpp"
 #include "../deck.hpp"
+#include "../fixed_vector.hpp"
+#include "../betting_rules.hpp"
+#include "../../common/constants.hpp"
 #include "table.hpp"
-#include <vector>
 #include <string>
 #include <cstdint>
 
@@ -21,26 +23,30 @@ enum class BettingRound {
 
 struct ActionHistory {
     Player* player;
-    std::string action; // "fold", "call", "raise"
+    Action action;
     int amount;
     uint64_t timestamp;
 };
 
+using SeatList = FixedVector<Player*, common::constants::MAX_SEATS>;
+
+// All per-hand state is stored inline with fixed capacities, so starting,
+// playing and finishing a hand never allocates.
 struct Hand {
-    std::string id; // UUID
+    uint64_t id; // unique per process, assigned by poker::startHand
     Table* table; // reference to Table
-    std::vector<Player*> players; // list of Player references participating
+    SeatList players; // list of Player references participating
     Deck deck; // shuffled deck for this hand
-    std::vector<Card> community_cards; // array of 0-5 cards
+    FixedVector<Card, common::constants::MAX_BOARD_CARDS> community_cards;
     int pot; // total chips in main pot
-    std::vector<SidePot> side_pots; // list of side pots
-    std::vector<int> player_bets; // total chips contributed by each player (aligned with players)
-    std::vector<bool> folded; // whether each player has folded (aligned with players)
+    FixedVector<SidePot, common::constants::MAX_SEATS> side_pots; // list of side pots
+    FixedVector<int, common::constants::MAX_SEATS> player_bets; // total chips contributed by each player (aligned with players)
+    FixedVector<bool, common::constants::MAX_SEATS> folded; // whether each player has folded (aligned with players)
     BettingRound current_betting_round;
     Player* current_player_to_act; // whose turn it is
     int min_raise; // minimum raise amount
-    std::vector<ActionHistory> history;
-    std::vector<Player*> winners; // populated at showdown
+    FixedVector<ActionHistory, common::constants::MAX_HAND_ACTIONS> history;
+    SeatList winners; // populated at showdown
     uint64_t completed_at; // timestamp when hand finished
 
     // Validation helper
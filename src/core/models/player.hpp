@@ -1,9 +1,9 @@
 #pragma once
 
 #include "../card.hpp"
+#include "../fixed_vector.hpp"
 #include "../../common/constants.hpp"
 #include <string>
-#include <vector>
 #include <cstdint>
 #include <optional>
 
@@ -21,7 +21,7 @@ struct Player {
     std::string name; // optional display name
     int stack; // current chip count
     int seat; // which seat at the table
-    std::vector<Card> hole_cards; // exactly 2 cards when in a hand
+    FixedVector<Card, common::constants::MAX_HOLE_CARDS> hole_cards; // exactly 2 cards when in a hand
     ConnectionStatus connection_status;
     uint64_t last_action_timestamp; // milliseconds since epoch
     std::optional<uint64_t> disconnected_at; // nullable timestamp
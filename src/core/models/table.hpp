@@ -1,8 +1,9 @@
 #pragma once
 
 #include "../card.hpp"
+#include "../fixed_vector.hpp"
+#include "../../common/constants.hpp"
 #include <cstdint>
-#include <vector>
 #include <optional>
 #include <string>
 
@@ -18,7 +19,7 @@ enum class TableState {
 
 struct SidePot {
     int amount;
-    std::vector<Player*> eligible_players;
+    FixedVector<Player*, common::constants::MAX_SEATS> eligible_players;
 };
 
 struct Table {
@@ -29,8 +30,8 @@ struct Table {
     Player* seat_2; // reference to Player in seat 2 (big blind)
     Hand* current_hand; // nullable, owned by TableManager as unique_ptr
     int pot; // total chips in main pot
-    std::vector<SidePot> side_pots;
-    std::vector<Card> community_cards; // 0-5 cards
+    FixedVector<SidePot, common::constants::MAX_SEATS> side_pots;
+    FixedVector<Card, common::constants::MAX_BOARD_CARDS> community_cards;
     int dealer_button_position; // 0 or 1
     TableState state;
 
@@ -4,32 +4,34 @@
 #include "models/hand.hpp"
 #include "hand_ranking.hpp"
 #include <algorithm>
-#include <vector>
+#include <array>
 #include <cassert>
 
 namespace pot {
 
-std::vector<SidePot> calculateSidePots(const std::vector<Player*>& players, const std::vector<int>& bets) {
+FixedVector<SidePot, common::constants::MAX_SEATS> calculateSidePots(span<Player* const> players, span<const int> bets) {
     assert(players.size() == bets.size());
-    std::vector<SidePot> side_pots;
+    assert(players.size() <= common::constants::MAX_SEATS);
+    FixedVector<SidePot, common::constants::MAX_SEATS> side_pots;
 
     if (players.empty()) {
         return side_pots;
     }
 
     // Create vector of indices to sort by bet amount
-    std::vector<size_t> indices(players.size());
-    for (size_t i = 0; i < players.size(); ++i) {
+    std::array<size_t, common::constants::MAX_SEATS> indices;
+    const size_t count = players.size();
+    for (size_t i = 0; i < count; ++i) {
         indices[i] = i;
     }
 
     // Sort indices by bet amount ascending
-    std::sort(indices.begin(), indices.end(),
+    std::sort(indices.begin(), indices.begin() + count,
         [&bets](size_t a, size_t b) { return bets[a] < bets[b]; });
 
     // Calculate side pots
     int previous_bet = 0;
-    for (size_t i = 0; i < indices.size(); ++i) {
+    for (size_t i = 0; i < count; ++i) {
         int current_bet = bets[indices[i]];
         if (current_bet == previous_bet) {
             continue;
@@ -37,10 +39,10 @@ std::vector<SidePot> calculateSidePots(const std::vector<Player*>& players, cons
 
         // Players from i to end are eligible for this side pot
         SidePot pot;
-        pot.amount = (current_bet - previous_bet) * (indices.size() - i);
+        pot.amount = (current_bet - previous_bet) * static_cast<int>(count - i);
 
         // Add eligible players
-        for (size_t j = i; j < indices.size(); ++j) {
+        for (size_t j = i; j < count; ++j) {
             pot.eligible_players.push_back(players[indices[j]]);
         }
 
@@ -51,9 +53,9 @@ std::vector<SidePot> calculateSidePots(const std::vector<Player*>& players, cons
     return side_pots;
 }
 
-std::vector<Player*> getEligiblePlayersForPot(const std::vector<Player*>& players, const std::vector<int>& bets, int pot_threshold) {
+SeatList getEligiblePlayersForPot(span<Player* const> players, span<const int> bets, int pot_threshold) {
     assert(players.size() == bets.size());
-    std::vector<Player*> eligible;
+    SeatList eligible;
 
     for (size_t i = 0; i < players.size(); ++i) {
         if (bets[i] >= pot_threshold) {
@@ -64,7 +66,7 @@ std::vector<Player*> getEligiblePlayersForPot(const std::vector<Player*>& player
     return eligible;
 }
 
-void distributePot(Hand& hand, const std::vector<Player*>& winners) {
+void distributePot(Hand& hand, span<Player* const> winners) {
     // Distribute main pot to winners (as before)
     if (!winners.empty() && hand.pot > 0) {
         int share = hand.pot / static_cast<int>(winners.size());
@@ -82,7 +84,7 @@ void distributePot(Hand& hand, const std::vector<Player*>& winners) {
     for (SidePot& side_pot : hand.side_pots) {
         if (side_pot.amount == 0) continue;
         // Filter winners who are eligible for this side pot
-        std::vector<Player*> eligible_winners;
+        SeatList eligible_winners;
         for (Player* winner : winners) {
             if (std::find(side_pot.eligible_players.begin(), side_pot.eligible_players.end(), winner) != side_pot.eligible_players.end()) {
                 eligible_winners.push_back(winner);
@@ -0,0 +1,185 @@
+#include "preflop_table.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'P', 'F', 'E', 'Q', 'T', 'B', 'L', '\0'};
+constexpr char RANK_CHARS[] = "23456789TJQKA";
+
+// Native-endian file header, followed by the class matrix then the combo matrix as float32
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_classes;
+    uint32_t num_combos;
+    uint32_t reserved;
+};
+
+constexpr std::size_t CLASS_ENTRIES = static_cast<std::size_t>(PreflopEquityTable::NUM_CLASSES) *
+                                      PreflopEquityTable::NUM_CLASSES;
+constexpr std::size_t COMBO_ENTRIES = static_cast<std::size_t>(PreflopEquityTable::NUM_COMBOS) *
+                                      PreflopEquityTable::NUM_COMBOS;
+constexpr std::size_t FILE_SIZE = sizeof(FileHeader) + (CLASS_ENTRIES + COMBO_ENTRIES) * sizeof(float);
+
+// The two cards of a hand as Card::toInt() values, lower first
+std::pair<int, int> holeCards(CardSet hand) {
+    if (hand.size() != 2) {
+        throw std::invalid_argument("Starting hand must have exactly two cards");
+    }
+    auto it = hand.begin();
+    int a = (*it).toInt();
+    int b = (*++it).toInt();
+    return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+}
+
+} // anonymous namespace
+
+PreflopEquityTable::PreflopEquityTable(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open preflop equity table: " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) != FILE_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("Preflop equity table has the wrong size: " + path);
+    }
+    void* mapping = ::mmap(nullptr, FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map preflop equity table: " + path);
+    }
+    mapping_ = mapping;
+    mapping_size_ = FILE_SIZE;
+
+    FileHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.num_classes != NUM_CLASSES || header.num_combos != NUM_COMBOS) {
+        unmap();
+        throw std::runtime_error("Unsupported preflop equity table format: " + path);
+    }
+
+    const char* base = static_cast<const char*>(mapping_) + sizeof(FileHeader);
+    class_equity_ = reinterpret_cast<const float*>(base);
+    combo_equity_ = class_equity_ + CLASS_ENTRIES;
+}
+
+PreflopEquityTable::~PreflopEquityTable() {
+    unmap();
+}
+
+PreflopEquityTable::PreflopEquityTable(PreflopEquityTable&& other) noexcept
+    : mapping_(other.mapping_),
+      mapping_size_(other.mapping_size_),
+      class_equity_(other.class_equity_),
+      combo_equity_(other.combo_equity_) {
+    other.mapping_ = nullptr;
+    other.mapping_size_ = 0;
+    other.class_equity_ = nullptr;
+    other.combo_equity_ = nullptr;
+}
+
+PreflopEquityTable& PreflopEquityTable::operator=(PreflopEquityTable&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        std::swap(mapping_, other.mapping_);
+        std::swap(mapping_size_, other.mapping_size_);
+        std::swap(class_equity_, other.class_equity_);
+        std::swap(combo_equity_, other.combo_equity_);
+    }
+    return *this;
+}
+
+void PreflopEquityTable::unmap() noexcept {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    class_equity_ = nullptr;
+    combo_equity_ = nullptr;
+}
+
+float PreflopEquityTable::equity(CardSet hero, CardSet villain) const {
+    if (hero.intersects(villain)) {
+        throw std::invalid_argument("Starting hands share a card");
+    }
+    return combo_equity_[static_cast<std::size_t>(comboIndex(hero)) * NUM_COMBOS + comboIndex(villain)];
+}
+
+int PreflopEquityTable::classIndex(CardSet hand) {
+    auto [low, high] = holeCards(hand);
+    int low_rank = low / NUM_SUITS;
+    int high_rank = high / NUM_SUITS;
+    bool suited = low % NUM_SUITS == high % NUM_SUITS;
+    return suited ? high_rank * NUM_RANKS + low_rank : low_rank * NUM_RANKS + high_rank;
+}
+
+std::string PreflopEquityTable::className(int class_index) {
+    if (class_index < 0 || class_index >= NUM_CLASSES) {
+        throw std::out_of_range("Starting hand class out of range");
+    }
+    int row = class_index / NUM_RANKS;
+    int col = class_index % NUM_RANKS;
+    if (row == col) {
+        return std::string(2, RANK_CHARS[row]);
+    }
+    if (row > col) {
+        return std::string{RANK_CHARS[row], RANK_CHARS[col], 's'};
+    }
+    return std::string{RANK_CHARS[col], RANK_CHARS[row], 'o'};
+}
+
+int PreflopEquityTable::comboIndex(CardSet hand) {
+    auto [low, high] = holeCards(hand);
+    return high * (high - 1) / 2 + low;
+}
+
+CardSet PreflopEquityTable::comboAt(int combo_index) {
+    if (combo_index < 0 || combo_index >= NUM_COMBOS) {
+        throw std::out_of_range("Combo index out of range");
+    }
+    int high = 1;
+    while ((high + 1) * high / 2 <= combo_index) {
+        ++high;
+    }
+    int low = combo_index - high * (high - 1) / 2;
+    return CardSet{Card(static_cast<Rank>(low / NUM_SUITS), static_cast<Suit>(low % NUM_SUITS)),
+                   Card(static_cast<Rank>(high / NUM_SUITS), static_cast<Suit>(high % NUM_SUITS))};
+}
+
+void PreflopEquityTable::write(const std::string& path, const std::vector<float>& class_equity,
+                               const std::vector<float>& combo_equity) {
+    if (class_equity.size() != CLASS_ENTRIES || combo_equity.size() != COMBO_ENTRIES) {
+        throw std::invalid_argument("Preflop equity tables have the wrong size");
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.num_classes = NUM_CLASSES;
+    header.num_combos = NUM_COMBOS;
+
+    // Write beside the target and rename so readers never map a half-written file
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(class_equity.data()), CLASS_ENTRIES * sizeof(float));
+        out.write(reinterpret_cast<const char*>(combo_equity.data()), COMBO_ENTRIES * sizeof(float));
+        if (!out) {
+            throw std::runtime_error("Failed to write preflop equity table: " + temp_path);
+        }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace preflop equity table: " + path);
+    }
+}
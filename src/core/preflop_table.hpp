@@ -0,0 +1,59 @@
+#pragma once
+
+#include "card.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Heads-up preflop all-in equities read from a precomputed file.
+//
+// The file holds a 169x169 matrix over canonical starting hands (AA, AKs,
+// AKo, ...) and a 1326x1326 matrix over exact two-card combos. Entry [a][b] is
+// hand a's pot share against hand b with ties split; combo pairs that share a
+// card are NaN. The file is mapped read-only so lookups cost one load.
+// Generate it with the preflop_table_gen tool.
+class PreflopEquityTable {
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int NUM_CLASSES = NUM_RANKS * NUM_RANKS;
+    static constexpr int NUM_COMBOS = NUM_CARDS * (NUM_CARDS - 1) / 2;
+
+    // Map a table file. Throws std::runtime_error if it is missing, truncated or of another version.
+    explicit PreflopEquityTable(const std::string& path);
+    ~PreflopEquityTable();
+
+    PreflopEquityTable(PreflopEquityTable&& other) noexcept;
+    PreflopEquityTable& operator=(PreflopEquityTable&& other) noexcept;
+    PreflopEquityTable(const PreflopEquityTable&) = delete;
+    PreflopEquityTable& operator=(const PreflopEquityTable&) = delete;
+
+    // Average equity of one starting-hand class against another
+    float classEquity(int hero_class, int villain_class) const {
+        return class_equity_[hero_class * NUM_CLASSES + villain_class];
+    }
+
+    // Exact equity of two disjoint two-card hands. Throws std::invalid_argument otherwise.
+    float equity(CardSet hero, CardSet villain) const;
+
+    // Class index on a 13x13 grid: pairs on the diagonal, suited hands at
+    // [high][low] and offsuit hands at [low][high], ranks as Rank values.
+    static int classIndex(CardSet hand);
+    static std::string className(int class_index);
+
+    // Combo index of two distinct cards, colex order over Card::toInt()
+    static int comboIndex(CardSet hand);
+    static CardSet comboAt(int combo_index);
+
+    // Write a table file. class_equity and combo_equity must hold NUM_CLASSES^2 and NUM_COMBOS^2 entries.
+    static void write(const std::string& path, const std::vector<float>& class_equity,
+                      const std::vector<float>& combo_equity);
+
+private:
+    void unmap() noexcept;
+
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    const float* class_equity_ = nullptr;
+    const float* combo_equity_ = nullptr;
+};
@@ -0,0 +1,28 @@
+#include "rng.hpp"
+#include <cerrno>
+#include <random>
+#include <stdexcept>
+#include <sys/random.h>
+
+namespace rng {
+
+void SystemRandom::refill() {
+    auto* bytes = reinterpret_cast<unsigned char*>(buffer_.data());
+    std::size_t filled = 0;
+    while (filled < sizeof(buffer_)) {
+        ssize_t got = ::getrandom(bytes + filled, sizeof(buffer_) - filled, 0);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("getrandom failed");
+        }
+        filled += static_cast<std::size_t>(got);
+    }
+    next_ = 0;
+}
+
+uint64_t entropySeed() {
+    thread_local SplitMix64 seeds((static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}());
+    return seeds();
+}
+
+} // namespace rng
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Random bit generators for dealing and simulation. All model
+// UniformRandomBitGenerator, so they also work with <random> distributions.
+namespace rng {
+
+// Tiny generator used for seeding and derived streams
+class SplitMix64 {
+public:
+    using result_type = uint64_t;
+
+    explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t state_;
+};
+
+// xoshiro256** (Blackman and Vigna): fast general-purpose generator for simulations
+class Xoshiro256StarStar {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256StarStar(uint64_t seed) {
+        SplitMix64 seeder(seed);
+        for (auto& word : state_) word = seeder();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::array<uint64_t, 4> state_;
+};
+
+// PCG32 (XSH-RR, O'Neill): small state with selectable independent streams
+class Pcg32 {
+public:
+    using result_type = uint32_t;
+
+    explicit Pcg32(uint64_t seed, uint64_t stream = 0xDA3E39CB94B95BDBull) : state_(0), increment_((stream << 1) | 1) {
+        (*this)();
+        state_ += seed;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        uint64_t old = state_;
+        state_ = old * 6364136223846793005ull + increment_;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+    }
+
+private:
+    uint64_t state_;
+    uint64_t increment_;
+};
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+// Counter-based: output block i of a stream is a keyed bijection of the
+// counter (i, stream), so any (seed, stream) position can be produced on any
+// thread without shared state. The seed is the key.
+class Philox4x32 {
+public:
+    using result_type = uint32_t;
+    using Block = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    explicit Philox4x32(uint64_t seed, uint64_t stream = 0)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}, stream_(stream), block_(0),
+          next_(BUFFER_WORDS) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        if (next_ == BUFFER_WORDS) refill();
+        return buffer_[next_++];
+    }
+
+    // Four outputs at a block index of this stream; independent of the generator's position
+    Block generate(uint64_t block) const { return bijection(counter(block), key_); }
+
+    // Raw Philox4x32-10 of a counter under a key
+    static Block bijection(const Block& counter, const Key& key) {
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < ROUNDS; ++round) {
+            uint64_t product0 = static_cast<uint64_t>(MULTIPLIER_0) * c0;
+            uint64_t product1 = static_cast<uint64_t>(MULTIPLIER_1) * c2;
+            c0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+            c1 = static_cast<uint32_t>(product1);
+            c2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+            c3 = static_cast<uint32_t>(product0);
+            k0 += WEYL_0;
+            k1 += WEYL_1;
+        }
+        return {c0, c1, c2, c3};
+    }
+
+private:
+    static constexpr int ROUNDS = 10;
+    static constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+    static constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+    static constexpr uint32_t WEYL_0 = 0x9E3779B9;
+    static constexpr uint32_t WEYL_1 = 0xBB67AE85;
+    // Blocks computed per refill; their round chains are independent, so the
+    // multiplies overlap instead of serializing on latency
+    static constexpr int BUFFER_BLOCKS = 4;
+    static constexpr int BUFFER_WORDS = BUFFER_BLOCKS * 4;
+
+    Block counter(uint64_t block) const {
+        return {static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), static_cast<uint32_t>(stream_),
+                static_cast<uint32_t>(stream_ >> 32)};
+    }
+
+    void refill() {
+        for (int b = 0; b < BUFFER_BLOCKS; ++b) {
+            Block words = bijection(counter(block_ + static_cast<uint64_t>(b)), key_);
+            for (int w = 0; w < 4; ++w) buffer_[b * 4 + w] = words[w];
+        }
+        block_ += BUFFER_BLOCKS;
+        next_ = 0;
+    }
+
+    Key key_;
+    uint64_t stream_;
+    uint64_t block_;
+    std::array<uint32_t, BUFFER_WORDS> buffer_{};
+    int next_;
+};
+
+// Operating system CSPRNG (getrandom), buffered to amortize the system call.
+// Throws std::runtime_error if the kernel cannot supply entropy.
+class SystemRandom {
+public:
+    using result_type = uint64_t;
+
+    SystemRandom() : next_(BUFFER_WORDS) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        if (next_ == BUFFER_WORDS) refill();
+        return buffer_[next_++];
+    }
+
+private:
+    static constexpr std::size_t BUFFER_WORDS = 32;
+
+    void refill();
+
+    std::array<uint64_t, BUFFER_WORDS> buffer_{};
+    std::size_t next_;
+};
+
+// Fresh 64-bit seed: a per-thread SplitMix64 stream seeded once from std::random_device
+uint64_t entropySeed();
+
+// Default-construct generators without a seed (SystemRandom), seed the rest from entropySeed()
+template <typename Rng>
+Rng makeSeeded() {
+    if constexpr (std::is_constructible_v<Rng, uint64_t>) {
+        return Rng(entropySeed());
+    } else {
+        return Rng();
+    }
+}
+
+// Unbiased value in [0, bound) using Lemire's multiply-and-reject method
+template <typename Rng>
+uint32_t uniformBelow(Rng& rng, uint32_t bound) {
+    auto next32 = [&rng]() {
+        if constexpr (sizeof(typename Rng::result_type) > sizeof(uint32_t)) {
+            return static_cast<uint32_t>(rng() >> 32);
+        } else {
+            return static_cast<uint32_t>(rng());
+        }
+    };
+    uint64_t product = static_cast<uint64_t>(next32()) * bound;
+    uint32_t low = static_cast<uint32_t>(product);
+    if (low < bound) {
+        uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>(next32()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32);
+}
+
+} // namespace rng
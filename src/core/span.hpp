@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Non-owning view over contiguous elements (a C++17 stand-in for std::span).
+template <typename T>
+class span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr span() noexcept : data_(nullptr), size_(0) {}
+    constexpr span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    template <std::size_t N>
+    constexpr span(T (&array)[N]) noexcept : data_(array), size_(N) {}
+
+    template <typename U, std::size_t N, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr span(std::array<U, N>& array) noexcept : data_(array.data()), size_(N) {}
+
+    template <typename U, std::size_t N, typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    constexpr span(const std::array<U, N>& array) noexcept : data_(array.data()), size_(N) {}
+
+    template <typename U, typename Alloc, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    span(std::vector<U, Alloc>& vector) noexcept : data_(vector.data()), size_(vector.size()) {}
+
+    template <typename U, typename Alloc,
+              typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    span(const std::vector<U, Alloc>& vector) noexcept : data_(vector.data()), size_(vector.size()) {}
+
+    // span<T> converts to span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr span(const span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr T& operator[](std::size_t index) const { return data_[index]; }
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    constexpr span subspan(std::size_t offset, std::size_t count) const { return span(data_ + offset, count); }
+
+private:
+    T* data_;
+    std::size_t size_;
+};
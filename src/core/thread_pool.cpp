@@ -0,0 +1,93 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+namespace {
+
+// Pool and queue index of the worker running on this thread, if any
+thread_local const ThreadPool* t_pool = nullptr;
+thread_local std::size_t t_worker_index = 0;
+
+} // anonymous namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queues_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::push(Task task) {
+    std::size_t index = t_pool == this
+        ? t_worker_index
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+    {
+        // Pairs with the predicate check in workerLoop so the wakeup cannot be lost
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::tryPop(std::size_t self, Task& task) {
+    {
+        WorkQueue& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkQueue& victim = *queues_[(self + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    t_pool = this;
+    t_worker_index = index;
+    Task task;
+    while (true) {
+        if (tryPop(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this]() { return stopping_ || pending_.load(std::memory_order_acquire) > 0; });
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
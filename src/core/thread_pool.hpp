@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed-size work-stealing thread pool.
+//
+// Each worker owns a deque: it pops its own work from the back and steals from
+// the front of other workers' deques when idle. Tasks submitted from a worker
+// go to that worker's deque; tasks submitted from outside are spread round-robin.
+class ThreadPool {
+public:
+    // Zero threads means one per hardware thread
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return threads_.size(); }
+
+    // Queue fn for execution. Waiting on the returned future from inside a
+    // pool task can deadlock; block only from outside threads.
+    template <typename Fn>
+    std::future<std::invoke_result_t<std::decay_t<Fn>>> submit(Fn&& fn) {
+        using Result = std::invoke_result_t<std::decay_t<Fn>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        std::future<Result> result = task->get_future();
+        push([task]() { (*task)(); });
+        return result;
+    }
+
+private:
+    using Task = std::function<void()>;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(Task task);
+    bool tryPop(std::size_t self, Task& task);
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> next_queue_{0};
+    std::atomic<std::size_t> pending_{0};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
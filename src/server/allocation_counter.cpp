@@ -0,0 +1,26 @@
+#include "metrics.hpp"
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations for poker_allocations_total. Linked into the server
+// executable only, so tests and benchmarks keep their own operator new.
+
+void* operator new(std::size_t size)
+{
+    metrics::increment(metrics::Counter::ALLOCATIONS);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,215 @@
+#include "client_message.hpp"
+#include "../core/hand.hpp"
+#include <array>
+#include <limits>
+#include <type_traits>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+constexpr std::array<const char*, CLIENT_MESSAGE_TYPE_COUNT> TYPE_NAMES = {"join", "action", "ping", "top_up"};
+
+// Messages are an object holding a payload object; anything deeper is skipped
+// but bounded so hostile input cannot recurse far
+constexpr std::size_t MAX_DEPTH = 8;
+
+template<typename T>
+int clampToInt(T value) {
+    if (value >= static_cast<T>(std::numeric_limits<int>::max())) {
+        return std::numeric_limits<int>::max();
+    }
+    if constexpr (std::is_signed_v<T>) {
+        if (value <= static_cast<T>(std::numeric_limits<int>::min())) {
+            return std::numeric_limits<int>::min();
+        }
+    }
+    return static_cast<int>(value);
+}
+
+// SAX handler that records the fields a ClientMessage needs. Returning false
+// from any callback stops the parse immediately.
+class ClientMessageSax {
+public:
+    using json = nlohmann::json;
+
+    explicit ClientMessageSax(ClientMessage& message) : message_(message) {}
+
+    bool hasType() const { return has_type_; }
+    bool knownType() const { return known_type_; }
+    bool hasPayload() const { return has_payload_; }
+
+    bool null() {
+        if (field_ == Field::PAYLOAD) {
+            // A null payload reads as an empty one
+            has_payload_ = true;
+            return done();
+        }
+        return skipOnly();
+    }
+
+    bool boolean(bool) { return skipOnly(); }
+
+    bool number_integer(json::number_integer_t value) { return amount(clampToInt(value)); }
+
+    bool number_unsigned(json::number_unsigned_t value) { return amount(clampToInt(value)); }
+
+    bool number_float(json::number_float_t value, const json::string_t&) { return amount(clampToInt(value)); }
+
+    bool string(json::string_t& value) {
+        switch (field_) {
+            case Field::TYPE:
+                has_type_ = true;
+                known_type_ = false;
+                for (std::size_t i = 0; i < TYPE_NAMES.size(); ++i) {
+                    if (value == TYPE_NAMES[i]) {
+                        message_.type = static_cast<ClientMessageType>(i);
+                        known_type_ = true;
+                        break;
+                    }
+                }
+                return done();
+            case Field::NAME:
+                message_.name = std::move(value);
+                return done();
+            case Field::PLAYER_ID:
+                message_.player_id = std::move(value);
+                return done();
+            case Field::HAND_ID:
+                message_.has_hand_id = true;
+                message_.hand_id = poker::parseHandId(value);
+                return done();
+            case Field::ACTION:
+                message_.has_action = true;
+                message_.action = parseAction(value);
+                return done();
+            default:
+                return skipOnly();
+        }
+    }
+
+    bool binary(json::binary_t&) { return false; }
+
+    bool start_object(std::size_t) {
+        if (depth_ > 0) {
+            if (field_ == Field::PAYLOAD) {
+                has_payload_ = true;
+                in_payload_ = true;
+            } else if (field_ != Field::NONE) {
+                return false;
+            }
+        }
+        return enter();
+    }
+
+    bool key(json::string_t& name) {
+        field_ = Field::NONE;
+        if (depth_ == 1) {
+            if (name == "type") {
+                field_ = Field::TYPE;
+            } else if (name == "payload") {
+                field_ = Field::PAYLOAD;
+            }
+        } else if (depth_ == 2 && in_payload_) {
+            if (name == "name") {
+                field_ = Field::NAME;
+            } else if (name == "player_id") {
+                field_ = Field::PLAYER_ID;
+            } else if (name == "hand_id") {
+                field_ = Field::HAND_ID;
+            } else if (name == "action") {
+                field_ = Field::ACTION;
+            } else if (name == "amount") {
+                field_ = Field::AMOUNT;
+            }
+        }
+        return true;
+    }
+
+    bool end_object() {
+        --depth_;
+        if (depth_ == 1) {
+            in_payload_ = false;
+        }
+        return done();
+    }
+
+    bool start_array(std::size_t) {
+        // Only skipped values may be arrays; the message itself must be an object
+        if (depth_ == 0 || field_ != Field::NONE) {
+            return false;
+        }
+        return enter();
+    }
+
+    bool end_array() {
+        --depth_;
+        return done();
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) { return false; }
+
+private:
+    enum class Field : uint8_t { NONE, TYPE, PAYLOAD, NAME, PLAYER_ID, HAND_ID, ACTION, AMOUNT };
+
+    bool enter() {
+        ++depth_;
+        field_ = Field::NONE;
+        return depth_ <= MAX_DEPTH;
+    }
+
+    bool done() {
+        field_ = Field::NONE;
+        return true;
+    }
+
+    // A scalar that no field wants: fine inside the message, not as the whole of it
+    bool skipOnly() {
+        if (depth_ == 0 || field_ != Field::NONE) {
+            return false;
+        }
+        return true;
+    }
+
+    bool amount(int value) {
+        if (field_ != Field::AMOUNT) {
+            return skipOnly();
+        }
+        message_.has_amount = true;
+        message_.amount = value;
+        return done();
+    }
+
+    ClientMessage& message_;
+    std::size_t depth_ = 0;
+    Field field_ = Field::NONE;
+    bool in_payload_ = false;
+    bool has_type_ = false;
+    bool known_type_ = false;
+    bool has_payload_ = false;
+};
+
+} // anonymous namespace
+
+const char* clientMessageTypeName(ClientMessageType type) {
+    auto index = static_cast<std::size_t>(type);
+    return index < TYPE_NAMES.size() ? TYPE_NAMES[index] : "unknown";
+}
+
+ClientMessage parseClientMessage(std::string_view text) {
+    ClientMessage message;
+    ClientMessageSax sax(message);
+    if (!nlohmann::json::sax_parse(text.begin(), text.end(), &sax)) {
+        message.error_code = "invalid_json";
+        message.error_message = "Failed to parse JSON";
+    } else if (!sax.hasType()) {
+        message.error_code = "invalid_json";
+        message.error_message = "Missing 'type' field";
+    } else if (!sax.hasPayload()) {
+        message.error_code = "invalid_json";
+        message.error_message = "Missing 'payload' field";
+    } else if (!sax.knownType()) {
+        message.error_code = "invalid_message_type";
+        message.error_message = "Unknown message type";
+    }
+    return message;
+}
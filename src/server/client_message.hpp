@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../core/betting_rules.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Client to server message types, in dispatch table order
+enum class ClientMessageType : uint8_t {
+    JOIN,
+    ACTION,
+    PING,
+    TOP_UP,
+};
+
+constexpr std::size_t CLIENT_MESSAGE_TYPE_COUNT = 4;
+
+// Wire name of a message type ("join", "action", "ping", "top_up")
+const char* clientMessageTypeName(ClientMessageType type);
+
+// A client message reduced to the fields its type uses. parseClientMessage fills
+// it in one SAX pass over the received text, without building a JSON DOM; fields
+// of other types, unknown keys and nested values are skipped.
+struct ClientMessage {
+    ClientMessageType type = ClientMessageType::PING;
+
+    // Set when the message cannot be dispatched; the code and text of the error response
+    const char* error_code = nullptr;
+    const char* error_message = nullptr;
+
+    // join
+    std::optional<std::string> name;
+    std::string player_id; // reconnecting player's id, empty if none
+
+    // action
+    bool has_hand_id = false;
+    bool has_action = false;
+    bool has_amount = false;
+    std::optional<uint64_t> hand_id;  // nullopt if not a well-formed hand id
+    std::optional<Action> action;     // nullopt if not fold, call or raise
+    int amount = 0;                   // clamped to the int range
+
+    // When the transport read the frame and when it was parsed, for the latency
+    // histograms (see metrics::traceReceived); default when the message is not timed
+    std::chrono::steady_clock::time_point received;
+    std::chrono::steady_clock::time_point parsed;
+
+    bool ok() const { return error_code == nullptr; }
+};
+
+// Parse a client message. Malformed JSON, wrong field types and nesting deeper
+// than a message ever needs stop the parse at the offending token.
+ClientMessage parseClientMessage(std::string_view text);
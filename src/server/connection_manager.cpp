@@ -1,97 +1,91 @@
 #include "connection_manager.hpp"
 
 ConnectionManager::ConnectionManager(boost::asio::io_context& ioc)
-    : ioc_(ioc)
+    : ConnectionManager(std::make_shared<TimingWheel>(ioc), ioc.get_executor())
+{
+}
+
+ConnectionManager::ConnectionManager(std::shared_ptr<TimingWheel> wheel, boost::asio::any_io_executor executor)
+    : wheel_(std::move(wheel)),
+      executor_(std::move(executor)),
+      state_(std::make_shared<State>())
 {
 }
 
 ConnectionManager::~ConnectionManager()
 {
-    std::lock_guard<std::mutex> lock(timers_mutex_);
-    for (auto& [player_id, timers] : timers_)
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    for (auto& [player_id, timers] : state_->timers)
     {
-        boost::system::error_code ec;
-        if (timers.grace_timer)
-        {
-            timers.grace_timer->cancel(ec);
-        }
-        if (timers.removal_timer)
-        {
-            timers.removal_timer->cancel(ec);
-        }
+        wheel_->cancel(timers.grace.handle);
+        wheel_->cancel(timers.removal.handle);
     }
-    timers_.clear();
+    state_->timers.clear();
 }
 
 void ConnectionManager::startGraceTimer(const std::string& player_id, int grace_time_ms, TimerCallback on_expiry)
 {
-    std::lock_guard<std::mutex> lock(timers_mutex_);
-    auto& timers = timers_[player_id];
-    if (!timers.grace_timer)
-    {
-        timers.grace_timer = std::make_unique<boost::asio::steady_timer>(ioc_);
-    }
-    else
-    {
-        timers.grace_timer->cancel();
-    }
-
-    timers.grace_timer->expires_after(std::chrono::milliseconds(grace_time_ms));
-    timers.grace_timer->async_wait([player_id, on_expiry](const boost::system::error_code& ec) {
-        if (!ec)
-        {
-            on_expiry(player_id);
-        }
-    });
+    startTimer(player_id, grace_time_ms, std::move(on_expiry), &PlayerTimers::grace);
 }
 
 void ConnectionManager::startRemovalTimer(const std::string& player_id, int removal_time_ms, TimerCallback on_expiry)
 {
-    std::lock_guard<std::mutex> lock(timers_mutex_);
-    auto& timers = timers_[player_id];
-    if (!timers.removal_timer)
-    {
-        timers.removal_timer = std::make_unique<boost::asio::steady_timer>(ioc_);
-    }
-    else
-    {
-        timers.removal_timer->cancel();
-    }
+    startTimer(player_id, removal_time_ms, std::move(on_expiry), &PlayerTimers::removal);
+}
+
+void ConnectionManager::startTimer(const std::string& player_id, int time_ms, TimerCallback on_expiry, Timer PlayerTimers::*timer)
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    Timer& slot = state_->timers[player_id].*timer;
+    wheel_->cancel(slot.handle);
 
-    timers.removal_timer->expires_after(std::chrono::milliseconds(removal_time_ms));
-    timers.removal_timer->async_wait([player_id, on_expiry](const boost::system::error_code& ec) {
-        if (!ec)
-        {
+    std::uint64_t id = ++state_->next_id;
+    std::weak_ptr<State> weak_state = state_;
+    slot.id = id;
+    slot.handle = wheel_->schedule(std::chrono::milliseconds(time_ms), executor_,
+        [weak_state, player_id, id, timer, on_expiry = std::move(on_expiry)]() {
+            auto state = weak_state.lock();
+            if (!state)
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                auto it = state->timers.find(player_id);
+                // Cancelled or re-armed after this expiry was queued
+                if (it == state->timers.end() || (it->second.*timer).id != id)
+                {
+                    return;
+                }
+                it->second.*timer = Timer{};
+                if (it->second.grace.id == 0 && it->second.removal.id == 0)
+                {
+                    state->timers.erase(it);
+                }
+            }
             on_expiry(player_id);
-        }
-    });
+        });
 }
 
 void ConnectionManager::cancelTimers(const std::string& player_id)
 {
-    std::lock_guard<std::mutex> lock(timers_mutex_);
-    auto it = timers_.find(player_id);
-    if (it != timers_.end())
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->timers.find(player_id);
+    if (it != state_->timers.end())
     {
-        if (it->second.grace_timer)
-        {
-            it->second.grace_timer->cancel();
-        }
-        if (it->second.removal_timer)
-        {
-            it->second.removal_timer->cancel();
-        }
-        timers_.erase(it);
+        wheel_->cancel(it->second.grace.handle);
+        wheel_->cancel(it->second.removal.handle);
+        state_->timers.erase(it);
     }
 }
 
 bool ConnectionManager::hasActiveTimers(const std::string& player_id) const
 {
-    std::lock_guard<std::mutex> lock(timers_mutex_);
-    auto it = timers_.find(player_id);
-    if (it == timers_.end())
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto it = state_->timers.find(player_id);
+    if (it == state_->timers.end())
     {
         return false;
     }
-    return it->second.grace_timer || it->second.removal_timer;
-}
\ No newline at end of file
+    return it->second.grace.id != 0 || it->second.removal.id != 0;
+}
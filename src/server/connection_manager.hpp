@@ -1,18 +1,29 @@
 #pragma once
 
+#include "timing_wheel.hpp"
 #include <boost/asio.hpp>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <mutex>
 
+// Grace and removal deadlines for disconnected players, armed on a timing wheel
+// rather than a steady_timer each. A timer that fires or is cancelled no longer
+// counts as active.
 class ConnectionManager {
 public:
     using TimerCallback = std::function<void(const std::string& player_id)>;
 
+    // Timers run on a wheel of their own and complete on ioc
     ConnectionManager(boost::asio::io_context& ioc);
 
+    // Timers are armed on wheel and callbacks run on executor, e.g. the strand of
+    // the table that owns the players
+    ConnectionManager(std::shared_ptr<TimingWheel> wheel, boost::asio::any_io_executor executor);
+    ~ConnectionManager();
+
     // Start grace timer for disconnected player
     void startGraceTimer(const std::string& player_id, int grace_time_ms, TimerCallback on_expiry);
 
@@ -26,13 +37,27 @@ public:
     bool hasActiveTimers(const std::string& player_id) const;
 
 private:
-    boost::asio::io_context& ioc_;
-    mutable std::mutex timers_mutex_;
+    struct Timer {
+        TimingWheel::Handle handle;
+        std::uint64_t id = 0; // 0 when not armed
+    };
 
     struct PlayerTimers {
-        std::unique_ptr<boost::asio::steady_timer> grace_timer;
-        std::unique_ptr<boost::asio::steady_timer> removal_timer;
+        Timer grace;
+        Timer removal;
     };
 
-    std::unordered_map<std::string, PlayerTimers> timers_;
+    // Shared with expiry callbacks, which can still be queued on the executor
+    // after this manager is gone
+    struct State {
+        std::mutex mutex;
+        std::unordered_map<std::string, PlayerTimers> timers;
+        std::uint64_t next_id = 0;
+    };
+
+    void startTimer(const std::string& player_id, int time_ms, TimerCallback on_expiry, Timer PlayerTimers::*timer);
+
+    std::shared_ptr<TimingWheel> wheel_;
+    boost::asio::any_io_executor executor_;
+    std::shared_ptr<State> state_;
 };
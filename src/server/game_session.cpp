@@ -4,30 +4,176 @@
 #include "../common/constants.hpp"
 #include "../common/logging.hpp"
 #include "../core/hand.hpp"
-#include <boost/beast.hpp>
+#include "../core/preflop_table.hpp"
+#include "message_writer.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 
-namespace beast = boost::beast;
+namespace {
+
+// Heap bytes behind a string; short ones fit in the string itself
+std::size_t heapBytes(const std::string& text)
+{
+    static const std::size_t inline_capacity = std::string().capacity();
+    return text.capacity() > inline_capacity ? text.capacity() + 1 : 0;
+}
+
+// Bucket array plus one node per entry (next pointer, value, cached hash) and
+// whatever the keys and values hold on the heap
+template <typename Map, typename HeapBytes>
+std::size_t mapBytes(const Map& map, HeapBytes entry_heap_bytes)
+{
+    std::size_t bytes = map.bucket_count() * sizeof(void*);
+    for (const auto& entry : map)
+    {
+        bytes += sizeof(void*) + sizeof(entry) + sizeof(std::size_t) + entry_heap_bytes(entry);
+    }
+    return bytes;
+}
+
+} // namespace
 
 GameSession::GameSession(boost::asio::io_context& ioc, int action_timeout_ms, int disconnect_grace_time_ms, int removal_timeout_ms)
-    : action_timeout_ms_(action_timeout_ms),
+    : GameSession(ioc, std::make_shared<TimingWheel>(ioc), action_timeout_ms, disconnect_grace_time_ms, removal_timeout_ms)
+{
+}
+
+GameSession::GameSession(boost::asio::io_context& ioc, std::shared_ptr<TimingWheel> timing_wheel, int action_timeout_ms,
+                         int disconnect_grace_time_ms, int removal_timeout_ms)
+    : strand_(boost::asio::make_strand(ioc)),
+      action_timeout_ms_(action_timeout_ms),
       disconnect_grace_time_ms_(disconnect_grace_time_ms),
       removal_timeout_ms_(removal_timeout_ms),
+      timing_wheel_(std::move(timing_wheel)),
       ioc_(ioc),
-      connection_manager_(ioc),
+      // Disconnection timers complete on the strand along with everything else
+      connection_manager_(timing_wheel_, strand_),
       player_state_manager_(connection_manager_, table_manager_, disconnect_grace_time_ms, removal_timeout_ms,
-          [self = shared_from_this()](const std::string& player_id) {
-              if (self) {
-                  self->broadcastPlayerRemoved(player_id);
-              }
+          // player_state_manager_ is a member, so the callback cannot outlive this
+          [this](const std::string& player_id) {
+              onPlayerRemoved(player_id);
           })
 {
+    publishSnapshot();
+}
+
+GameSession::~GameSession()
+{
+    timing_wheel_->cancel(action_timer_);
+}
+
+nlohmann::json GameSession::welcomeMessage(const std::string& player_id, const nlohmann::json& table_id)
+{
+    return {
+        {"type", "welcome"},
+        {"table_id", table_id},
+        {"payload", {
+            {"player_id", player_id},
+            {"table", {
+                {"seat_1", nullptr},
+                {"seat_2", nullptr},
+                {"current_hand", nullptr},
+                {"pot", 0},
+                {"community_cards", nlohmann::json::array()},
+                {"dealer_button_position", common::constants::DEFAULT_DEALER_POSITION}
+            }}
+        }}
+    };
+}
+
+int GameSession::seatedPlayers() const
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    return static_cast<int>(snapshot_.seated_ids.size());
+}
+
+std::size_t GameSession::stateBytes() const
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    return snapshot_.state_bytes;
+}
+
+bool GameSession::hasActiveHand() const
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    return snapshot_.hand_active;
+}
+
+bool GameSession::isSeated(const std::string& player_id) const
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    for (const std::string& id : snapshot_.seated_ids)
+    {
+        if (id == player_id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GameSession::awaitsReconnect(const std::string& player_id) const
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    for (std::size_t i = 0; i < snapshot_.seated_ids.size(); ++i)
+    {
+        if (snapshot_.seated_ids[i] == player_id)
+        {
+            return snapshot_.awaiting_reconnect[i];
+        }
+    }
+    return false;
+}
+
+bool GameSession::reserveSeat()
+{
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    if (snapshot_.seated_ids.size() + static_cast<std::size_t>(snapshot_.reserved_seats) >= 2)
+    {
+        return false;
+    }
+    ++snapshot_.reserved_seats;
+    return true;
+}
+
+void GameSession::publishSnapshot(int released_reservations)
+{
+    const Table& table = table_manager_.getTable();
+    // The hand and its history are stored inline, so only seats and sessions reach the heap
+    std::size_t state_bytes = sizeof(GameSession) + heapBytes(table.id);
+    state_bytes += mapBytes(player_sessions_, [](const auto& entry) { return heapBytes(entry.first); });
+    state_bytes += mapBytes(session_to_player_, [](const auto& entry) { return heapBytes(entry.second); });
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot_.reserved_seats -= released_reservations;
+    snapshot_.seated_ids.clear();
+    snapshot_.awaiting_reconnect.clear();
+    for (const Player* player : {table.seat_1, table.seat_2})
+    {
+        if (player)
+        {
+            snapshot_.seated_ids.push_back(player->id);
+            snapshot_.awaiting_reconnect.push_back(player->connection_status == ConnectionStatus::DISCONNECTED ||
+                                                   player->connection_status == ConnectionStatus::RECONNECTING);
+            state_bytes += sizeof(Player) + heapBytes(player->id) + heapBytes(player->name);
+        }
+    }
+    snapshot_.hand_active = table_manager_.getCurrentHand() != nullptr;
+    state_bytes += snapshot_.seated_ids.capacity() * sizeof(std::string);
+    for (const std::string& id : snapshot_.seated_ids)
+    {
+        state_bytes += heapBytes(id);
+    }
+    snapshot_.state_bytes = state_bytes;
 }
 
 nlohmann::json GameSession::createErrorResponse(const std::string& code, const std::string& message) const
 {
     const Hand* hand = table_manager_.getCurrentHand();
-    common::log::log(common::log::Level::WARN, "Error response: " + code + " - " + message + " (current hand: " + (hand ? hand->id : "none") + ")");
+    common::log::log(common::log::Level::WARN, "Error response: " + code + " - " + message + " (current hand: " + (hand ? poker::formatHandId(hand->id) : "none") + ")");
     return {
         {"type", "error"},
         {"payload", {
@@ -37,50 +183,93 @@ nlohmann::json GameSession::createErrorResponse(const std::string& code, const s
     };
 }
 
-void GameSession::handleMessage(const std::string& message, std::shared_ptr<WebSocketSession> session)
+void GameSession::handleMessage(std::string_view message, std::shared_ptr<Transport> session)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "handleMessage: null session");
         return;
     }
+    // Parsed on the caller's thread, while the view into its receive buffer is valid
+    ClientMessage parsed = parseClientMessage(message);
+    metrics::traceReceived(parsed);
+    metrics::countReceived(parsed);
+    handleClientMessage(std::move(parsed), std::move(session));
+}
 
-    try
-    {
-        nlohmann::json json = nlohmann::json::parse(message);
-        if (!json.contains("type")) {
-            sendJson(session, createErrorResponse("invalid_json", "Missing 'type' field"));
-            return;
-        }
-        if (!json.contains("payload")) {
-            sendJson(session, createErrorResponse("invalid_json", "Missing 'payload' field"));
-            return;
-        }
-        std::string type = json.at("type").get<std::string>();
+void GameSession::handleClientMessage(ClientMessage message, std::shared_ptr<Transport> session)
+{
+    if (!session) {
+        common::log::log(common::log::Level::ERROR, "handleClientMessage: null session");
+        return;
+    }
+    boost::asio::dispatch(strand_, [self = shared_from_this(), message = std::move(message), session = std::move(session)]() {
+        self->doHandleMessage(message, session);
+        self->publishSnapshot();
+    });
+}
 
-        if (type == "join")
-        {
-            handleJoin(json.at("payload"), session);
-        }
-        else if (type == "action")
-        {
-            handleAction(json.at("payload"), session);
-        }
-        else if (type == "ping")
+void GameSession::handleReservedJoin(ClientMessage message, std::shared_ptr<Transport> session)
+{
+    boost::asio::dispatch(strand_, [self = shared_from_this(), message = std::move(message), session = std::move(session)]() {
+        if (session)
         {
-            handlePing(session);
+            self->doHandleMessage(message, session);
         }
-        else if (type == "top_up")
+        self->publishSnapshot(1);
+    });
+}
+
+void GameSession::handleReconnectJoin(ClientMessage message, std::shared_ptr<Transport> session)
+{
+    boost::asio::dispatch(strand_, [self = shared_from_this(), message = std::move(message), session = std::move(session)]() {
+        bool accepted = false;
         {
-            handleTopUp(json.at("payload"), session);
+            metrics::Handling handling(message);
+            accepted = self->reconnectPlayer(message.player_id, session);
+            if (!accepted)
+            {
+                // The seat was reclaimed or freed since the registry looked
+                self->sendJson(session, self->createErrorResponse("reconnect_failed", "Player is not waiting to reconnect"));
+                auto it = self->session_to_player_.find(session);
+                if (it != self->session_to_player_.end())
+                {
+                    self->removeSession(it->second);
+                }
+            }
         }
-        else
+        self->publishSnapshot();
+        if (self->reconnect_handler_)
         {
-            sendJson(session, createErrorResponse("invalid_message_type", "Unknown message type"));
+            self->reconnect_handler_(session, message.player_id, accepted);
         }
+    });
+}
+
+void GameSession::doHandleMessage(const ClientMessage& message, const std::shared_ptr<Transport>& session)
+{
+    static constexpr std::array<MessageHandler, CLIENT_MESSAGE_TYPE_COUNT> handlers = {
+        &GameSession::handleJoin,   // JOIN
+        &GameSession::handleAction, // ACTION
+        &GameSession::handlePing,   // PING
+        &GameSession::handleTopUp,  // TOP_UP
+    };
+
+    metrics::Handling handling(message);
+    if (!message.ok())
+    {
+        sendJson(session, createErrorResponse(message.error_code, message.error_message));
+        return;
     }
-    catch (const nlohmann::json::exception& e)
+    try
     {
-        sendJson(session, createErrorResponse("invalid_json", "Failed to parse JSON"));
+        auto started = std::chrono::steady_clock::now();
+        (this->*handlers[static_cast<std::size_t>(message.type)])(message, session);
+        if (message.type == ClientMessageType::ACTION)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - started;
+            metrics::observe(metrics::Histogram::ACTION_LATENCY_US,
+                             std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+        }
     }
     catch (const std::exception& e)
     {
@@ -89,33 +278,25 @@ void GameSession::handleMessage(const std::string& message, std::shared_ptr<WebS
     }
 }
 
-void GameSession::sendWelcome(std::shared_ptr<WebSocketSession> session)
+void GameSession::sendWelcome(std::shared_ptr<Transport> session)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "sendWelcome: null session");
         return;
     }
+    boost::asio::dispatch(strand_, [self = shared_from_this(), session = std::move(session)]() {
+        self->doSendWelcome(session);
+    });
+}
 
+void GameSession::doSendWelcome(const std::shared_ptr<Transport>& session)
+{
     std::string player_id = generatePlayerId();
     registerSession(player_id, session);
 
     common::log::log(common::log::Level::INFO, "Welcome sent to player_id: " + player_id);
 
-    nlohmann::json welcome = {
-        {"type", "welcome"},
-        {"payload", {
-            {"player_id", player_id},
-            {"table", {
-                {"seat_1", nullptr},
-                {"seat_2", nullptr},
-                {"current_hand", nullptr},
-                {"pot", 0},
-                {"community_cards", nlohmann::json::array()},
-                {"dealer_button_position", common::constants::DEFAULT_DEALER_POSITION}
-            }}
-        }}
-    };
-    sendJson(session, welcome);
+    sendJson(session, welcomeMessage(player_id, tableId()));
 }
 
 void GameSession::broadcastHandStarted()
@@ -126,55 +307,22 @@ void GameSession::broadcastHandStarted()
         return;
     }
 
-    const Table& table = table_manager_.getTable();
-
-    nlohmann::json players_array = nlohmann::json::array();
     for (Player* player : hand->players)
     {
         if (!player) {
             common::log::log(common::log::Level::WARN, "broadcastHandStarted: null player in hand->players");
-            continue;
         }
-        nlohmann::json player_json;
-        player_json["player_id"] = player->id;
-        player_json["stack"] = player->stack;
-        // Include hole cards (convert Card to string)
-        nlohmann::json cards_json = nlohmann::json::array();
-        for (const Card& card : player->hole_cards)
-        {
-            cards_json.push_back(card.toString());
-        }
-        player_json["hole_cards"] = cards_json;
-        players_array.push_back(player_json);
     }
 
-    // Determine small blind and big blind amounts (fixed per spec)
-    int small_blind = common::constants::SMALL_BLIND;
-    int big_blind = common::constants::BIG_BLIND;
-
     // Determine current player to act ID
-    std::string current_player_id = "";
-    if (hand->current_player_to_act)
-    {
-        current_player_id = hand->current_player_to_act->id;
-    }
-
-    nlohmann::json payload = {
-        {"hand_id", hand->id},
-        {"players", players_array},
-        {"small_blind", small_blind},
-        {"big_blind", big_blind},
-        {"dealer_position", table.dealer_button_position},
-        {"current_player_to_act", current_player_id},
-        {"min_raise", hand->min_raise}
-    };
-
-    nlohmann::json message = {
-        {"type", "hand_started"},
-        {"payload", payload}
-    };
-
-    broadcastJson(message);
+    static const std::string no_player;
+    const std::string& current_player_id = hand->current_player_to_act ? hand->current_player_to_act->id : no_player;
+
+    // Blinds are fixed per spec
+    broadcastPayload(messages::handStarted(tableId(), hand->id, hand->players,
+                                           common::constants::SMALL_BLIND, common::constants::BIG_BLIND,
+                                           table_manager_.getTable().dealer_button_position,
+                                           current_player_id, hand->min_raise));
 }
 
 void GameSession::sendActionRequest(const std::string& player_id)
@@ -191,9 +339,6 @@ void GameSession::sendActionRequest(const std::string& player_id)
         return;
     }
 
-    // Determine possible actions (simplified - should check actual betting state)
-    nlohmann::json possible_actions = nlohmann::json::array({"fold", "call", "raise"});
-
     // Calculate call amount: amount needed to match the highest bet
     int call_amount = 0;
     int max_bet = 0;
@@ -220,40 +365,73 @@ void GameSession::sendActionRequest(const std::string& player_id)
     // Max raise is player's stack
     int max_raise = player->stack;
 
-    // Timeout (configurable, default 30 seconds)
-    int timeout_ms = common::constants::ACTION_TIMEOUT_MS;
+    // The clock runs whether or not the player is connected to hear about it
+    armActionTimer();
 
-    nlohmann::json payload = {
-        {"hand_id", hand->id},
-        {"possible_actions", possible_actions},
-        {"call_amount", call_amount},
-        {"min_raise", min_raise},
-        {"max_raise", max_raise},
-        {"timeout_ms", timeout_ms}
-    };
+    // Send to specific player; possible actions are fixed (simplified - should check actual betting state)
+    auto session_it = player_sessions_.find(player_id);
+    if (session_it != player_sessions_.end() && session_it->second)
+    {
+        session_it->second->send(messages::actionRequest(tableId(), hand->id, call_amount, min_raise, max_raise, action_timeout_ms_));
+    }
+}
 
-    nlohmann::json message = {
-        {"type", "action_request"},
-        {"payload", payload}
-    };
+void GameSession::armActionTimer()
+{
+    timing_wheel_->cancel(action_timer_);
+    std::uint64_t timer_id = ++action_timer_id_;
+    action_timer_ = timing_wheel_->schedule(std::chrono::milliseconds(action_timeout_ms_), strand_,
+        [weak_self = weak_from_this(), timer_id]() {
+            if (auto self = weak_self.lock())
+            {
+                self->onActionTimeout(timer_id);
+                self->publishSnapshot();
+            }
+        });
+}
+
+void GameSession::cancelActionTimer()
+{
+    timing_wheel_->cancel(action_timer_);
+    action_timer_ = TimingWheel::Handle();
+    ++action_timer_id_;
+}
 
-    // Send to specific player
-    std::shared_ptr<WebSocketSession> session;
+void GameSession::onActionTimeout(std::uint64_t timer_id)
+{
+    if (timer_id != action_timer_id_)
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        auto session_it = player_sessions_.find(player_id);
-        if (session_it != player_sessions_.end())
-        {
-            session = session_it->second;
+        return;
+    }
+    action_timer_ = TimingWheel::Handle();
+
+    const Hand* hand = table_manager_.getCurrentHand();
+    if (!hand || !hand->current_player_to_act)
+    {
+        return;
+    }
+    std::string player_id = hand->current_player_to_act->id;
+
+    int max_bet = 0;
+    int player_bet = 0;
+    for (size_t i = 0; i < hand->players.size() && i < hand->player_bets.size(); ++i) {
+        max_bet = std::max(max_bet, hand->player_bets[i]);
+        if (hand->players[i] && hand->players[i]->id == player_id) {
+            player_bet = hand->player_bets[i];
         }
     }
-    if (session)
+    // Check when nothing is owed, fold otherwise
+    Action action = max_bet == player_bet ? Action::CALL : Action::FOLD;
+
+    metrics::increment(metrics::Counter::ACTION_TIMEOUTS);
+    common::log::log(common::log::Level::INFO, "Action timeout: " + std::string(actionName(action)) + " for player: " + player_id + " hand_id: " + poker::formatHandId(hand->id));
+    if (!applyPlayerAction(player_id, action, 0))
     {
-        sendJson(session, message);
+        common::log::log(common::log::Level::ERROR, "onActionTimeout: table rejected " + std::string(actionName(action)) + " for player: " + player_id);
     }
 }
 
-void GameSession::broadcastActionApplied(const std::string& player_id, const std::string& action, int amount)
+void GameSession::broadcastActionApplied(const std::string& player_id, Action action, int amount)
 {
     const Hand* hand = table_manager_.getCurrentHand();
     if (!hand) {
@@ -269,28 +447,11 @@ void GameSession::broadcastActionApplied(const std::string& player_id, const std
     }
 
     // Determine next player to act
-    std::string next_player_id = "";
-    if (hand->current_player_to_act)
-    {
-        next_player_id = hand->current_player_to_act->id;
-    }
+    static const std::string no_player;
+    const std::string& next_player_id = hand->current_player_to_act ? hand->current_player_to_act->id : no_player;
 
-    nlohmann::json payload = {
-        {"hand_id", hand->id},
-        {"player_id", player_id},
-        {"action", action},
-        {"amount", amount},
-        {"new_stack", player->stack},
-        {"pot", hand->pot},
-        {"next_player_to_act", next_player_id}
-    };
-
-    nlohmann::json message = {
-        {"type", "action_applied"},
-        {"payload", payload}
-    };
-
-    broadcastJson(message);
+    broadcastPayload(messages::actionApplied(tableId(), hand->id, player_id, action, amount, player->stack, hand->pot,
+                                             next_player_id));
 }
 
 void GameSession::broadcastHandCompleted()
@@ -301,10 +462,6 @@ void GameSession::broadcastHandCompleted()
         return;
     }
 
-    nlohmann::json winners = nlohmann::json::array();
-    nlohmann::json pot_distribution = nlohmann::json::array();
-    nlohmann::json updated_stacks = nlohmann::json::object();
-
     // Compute total pot (main + side pots)
     int total_pot = hand->pot;
     for (const SidePot& side_pot : hand->side_pots) {
@@ -312,12 +469,13 @@ void GameSession::broadcastHandCompleted()
     }
 
     // Determine winners (use hand->winners if populated, else compute)
-    std::vector<Player*> win_players = hand->winners;
+    SeatList win_players = hand->winners;
     if (win_players.empty()) {
         win_players = poker::determineWinners(*hand);
     }
 
-    // Prepare winners array and pot distribution
+    // Split the pot between winners (single pot for simplicity)
+    FixedVector<messages::Winner, common::constants::MAX_SEATS> winners;
     if (!win_players.empty() && total_pot > 0) {
         int remainder = total_pot % win_players.size();
         int share = (total_pot - remainder) / win_players.size();
@@ -328,45 +486,32 @@ void GameSession::broadcastHandCompleted()
                 continue;
             }
             int amount = share + (i < static_cast<size_t>(remainder) ? 1 : 0);
-            // Winner entry
-            nlohmann::json winner_json = {
-                {"player_id", winner->id},
-                {"amount_won", amount},
-                {"hand_rank", "unknown"}
-            };
-            winners.push_back(winner_json);
-            // Pot distribution entry (single pot for simplicity)
-            nlohmann::json dist_json = {
-                {"pot_index", 0},
-                {"winner_id", winner->id},
-                {"amount", amount}
-            };
-            pot_distribution.push_back(dist_json);
+            winners.push_back({&winner->id, amount});
         }
     }
 
     // Updated stacks (current stack of each player)
     for (Player* player : hand->players) {
-        if (player) {
-            updated_stacks[player->id] = player->stack;
-        } else {
+        if (!player) {
             common::log::log(common::log::Level::WARN, "broadcastHandCompleted: null player in hand->players");
         }
     }
 
-    nlohmann::json payload = {
-        {"hand_id", hand->id},
-        {"winners", winners},
-        {"pot_distribution", pot_distribution},
-        {"updated_stacks", updated_stacks}
-    };
-
-    nlohmann::json message = {
-        {"type", "hand_completed"},
-        {"payload", payload}
-    };
+    // All-in equity of each hand's hole cards against the other's, rounded for the wire
+    FixedVector<messages::AllInEquity, common::constants::MAX_SEATS> equities;
+    if (preflop_table_ && hand->players.size() == 2 && hand->players[0] && hand->players[1] &&
+        hand->players[0]->hole_cards.size() == 2 && hand->players[1]->hole_cards.size() == 2) {
+        for (std::size_t i = 0; i < 2; ++i) {
+            const Player* hero = hand->players[i];
+            const Player* villain = hand->players[1 - i];
+            double equity = preflop_table_->equity(CardSet(hero->hole_cards), CardSet(villain->hole_cards));
+            int invested = i < hand->player_bets.size() ? hand->player_bets[i] : 0;
+            double ev = equity * total_pot - invested;
+            equities.push_back({&hero->id, std::round(equity * 1e4) / 1e4, std::round(ev * 1e2) / 1e2});
+        }
+    }
 
-    broadcastJson(message);
+    broadcastPayload(messages::handCompleted(tableId(), hand->id, winners, hand->players, equities));
 }
 
 void GameSession::broadcastPlayerRemoved(const std::string& player_id)
@@ -384,7 +529,7 @@ void GameSession::broadcastPlayerRemoved(const std::string& player_id)
         {"type", "player_removed"},
         {"payload", payload}
     };
-    broadcastJson(message);
+    broadcastJson(std::move(message));
 }
 
 void GameSession::broadcastPlayerReconnected(const std::string& player_id)
@@ -396,19 +541,19 @@ void GameSession::broadcastPlayerReconnected(const std::string& player_id)
         {"type", "player_reconnected"},
         {"payload", payload}
     };
-    broadcastJson(message);
+    broadcastJson(std::move(message));
 }
 
-void GameSession::registerSession(const std::string& player_id, std::shared_ptr<WebSocketSession> session)
+void GameSession::registerSession(const std::string& player_id, std::shared_ptr<Transport> session)
 {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
-    player_sessions_[player_id] = session;
-    session_to_player_[session] = player_id;
+    boost::asio::dispatch(strand_, [self = shared_from_this(), player_id, session = std::move(session)]() {
+        self->player_sessions_[player_id] = session;
+        self->session_to_player_[session] = player_id;
+    });
 }
 
 void GameSession::removeSession(const std::string& player_id)
 {
-    std::lock_guard<std::mutex> lock(sessions_mutex_);
     auto it = player_sessions_.find(player_id);
     if (it != player_sessions_.end())
     {
@@ -417,16 +562,22 @@ void GameSession::removeSession(const std::string& player_id)
     }
 }
 
-void GameSession::onDisconnect(std::shared_ptr<WebSocketSession> session)
+void GameSession::onDisconnect(std::shared_ptr<Transport> session)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "onDisconnect: null session");
         return;
     }
+    boost::asio::dispatch(strand_, [self = shared_from_this(), session = std::move(session)]() {
+        self->doOnDisconnect(session);
+        self->publishSnapshot();
+    });
+}
 
+void GameSession::doOnDisconnect(const std::shared_ptr<Transport>& session)
+{
     std::string player_id;
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
         auto it = session_to_player_.find(session);
         if (it == session_to_player_.end())
         {
@@ -454,7 +605,38 @@ void GameSession::onDisconnect(std::shared_ptr<WebSocketSession> session)
         {"type", "player_disconnected"},
         {"payload", payload}
     };
-    broadcastJson(message);
+    broadcastJson(std::move(message));
+}
+
+void GameSession::setPlayerRemovedHandler(std::function<void(const std::string&)> handler)
+{
+    player_removed_handler_ = std::move(handler);
+}
+
+void GameSession::setReconnectHandler(ReconnectHandler handler)
+{
+    reconnect_handler_ = std::move(handler);
+}
+
+void GameSession::setPreflopTable(std::shared_ptr<const PreflopEquityTable> preflop_table)
+{
+    preflop_table_ = std::move(preflop_table);
+}
+
+void GameSession::onPlayerRemoved(const std::string& player_id)
+{
+    broadcastPlayerRemoved(player_id);
+    // A hand in progress still points at the player, so its seat is only freed between hands
+    if (!table_manager_.getCurrentHand())
+    {
+        table_manager_.removePlayer(player_id);
+    }
+    // Timer callbacks run outside the entry points that publish
+    publishSnapshot();
+    if (player_removed_handler_)
+    {
+        player_removed_handler_(player_id);
+    }
 }
 
 std::string GameSession::generatePlayerId()
@@ -462,86 +644,35 @@ std::string GameSession::generatePlayerId()
     return common::uuid::generate();
 }
 
-void GameSession::handleJoin(const nlohmann::json& payload, std::shared_ptr<WebSocketSession> session)
+void GameSession::handleJoin(const ClientMessage& message, const std::shared_ptr<Transport>& session)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "handleJoin: null session");
         return;
     }
 
-    if (!payload.contains("name")) {
+    if (!message.name) {
         sendJson(session, createErrorResponse("invalid_input", "Missing 'name' field"));
         return;
     }
-    std::string name = std::move(payload.at("name").get<std::string>());
+    const std::string& name = *message.name;
     if (name.empty()) {
         sendJson(session, createErrorResponse("invalid_input", "Player name cannot be empty"));
         return;
     }
 
     // Optional player_id for reconnection
-    std::string provided_player_id;
-    if (payload.contains("player_id"))
-    {
-        provided_player_id = std::move(payload.at("player_id").get<std::string>());
-    }
+    const std::string& provided_player_id = message.player_id;
 
-    // If player_id provided, attempt reconnection
-    if (!provided_player_id.empty())
+    // If player_id provided, attempt reconnection; otherwise fall through to new player logic
+    if (!provided_player_id.empty() && reconnectPlayer(provided_player_id, session))
     {
-        auto player = table_manager_.getPlayer(provided_player_id);
-        if (player && (player->connection_status == ConnectionStatus::DISCONNECTED ||
-                       player->connection_status == ConnectionStatus::RECONNECTING))
-        {
-            {
-                std::lock_guard<std::mutex> lock(sessions_mutex_);
-                auto existing_session_it = player_sessions_.find(provided_player_id);
-                if (existing_session_it != player_sessions_.end() && existing_session_it->second != session)
-                {
-                    sendJson(session, createErrorResponse("player_already_connected", "Player already connected with another session"));
-                    return;
-                }
-
-                auto current_it = session_to_player_.find(session);
-                if (current_it != session_to_player_.end())
-                {
-                    std::string old_player_id = current_it->second;
-                    player_sessions_.erase(old_player_id);
-                    session_to_player_.erase(current_it);
-                }
-                player_sessions_[provided_player_id] = session;
-                session_to_player_[session] = provided_player_id;
-            }
-
-            // Cancel any disconnection timers
-            connection_manager_.cancelTimers(provided_player_id);
-
-            // Update player state
-            player_state_manager_.onReconnect(*player);
-
-            common::log::log(common::log::Level::INFO, "Player reconnected: " + provided_player_id);
-
-            // Broadcast reconnection
-            broadcastPlayerReconnected(provided_player_id);
-
-            // Send join acknowledgment
-            nlohmann::json response = {
-                {"type", "join_ack"},
-                {"payload", {
-                    {"player_id", provided_player_id},
-                    {"seat", player->seat}
-                }}
-            };
-            sendJson(session, response);
-            return;
-        }
-        // If player not found or not disconnected, fall through to new player logic
+        return;
     }
 
     // Get player_id from session mapping (default welcome-assigned)
     std::string player_id;
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
         auto it = session_to_player_.find(session);
         if (it == session_to_player_.end())
         {
@@ -563,7 +694,7 @@ void GameSession::handleJoin(const nlohmann::json& payload, std::shared_ptr<WebS
                 {"seat", existing_player->seat}
             }}
         };
-        sendJson(session, response);
+        sendJson(session, std::move(response));
         return;
     }
 
@@ -614,7 +745,7 @@ void GameSession::handleJoin(const nlohmann::json& payload, std::shared_ptr<WebS
             {"seat", seat}
         }}
     };
-    sendJson(session, response);
+    sendJson(session, std::move(response));
 
     // If both seats are now occupied, start a hand
     if (table_manager_.isReadyForHand())
@@ -622,30 +753,81 @@ void GameSession::handleJoin(const nlohmann::json& payload, std::shared_ptr<WebS
         if (table_manager_.startHand())
         {
             common::log::log(common::log::Level::INFO, "Hand started with both players");
+            metrics::increment(metrics::Counter::HANDS_STARTED);
             broadcastHandStarted();
+            const Hand* hand = table_manager_.getCurrentHand();
+            if (hand && hand->current_player_to_act)
+            {
+                sendActionRequest(hand->current_player_to_act->id);
+            }
         }
     }
 }
 
-void GameSession::handleAction(const nlohmann::json& payload, std::shared_ptr<WebSocketSession> session)
+bool GameSession::reconnectPlayer(const std::string& player_id, const std::shared_ptr<Transport>& session)
+{
+    auto player = table_manager_.getPlayer(player_id);
+    if (!player || (player->connection_status != ConnectionStatus::DISCONNECTED &&
+                    player->connection_status != ConnectionStatus::RECONNECTING))
+    {
+        return false;
+    }
+    auto existing_session_it = player_sessions_.find(player_id);
+    if (existing_session_it != player_sessions_.end() && existing_session_it->second != session)
+    {
+        return false;
+    }
+
+    auto current_it = session_to_player_.find(session);
+    if (current_it != session_to_player_.end())
+    {
+        std::string old_player_id = current_it->second;
+        player_sessions_.erase(old_player_id);
+        session_to_player_.erase(current_it);
+    }
+    player_sessions_[player_id] = session;
+    session_to_player_[session] = player_id;
+
+    // Cancel any disconnection timers
+    connection_manager_.cancelTimers(player_id);
+
+    // Update player state
+    player_state_manager_.onReconnect(*player);
+
+    common::log::log(common::log::Level::INFO, "Player reconnected: " + player_id);
+
+    // Broadcast reconnection
+    broadcastPlayerReconnected(player_id);
+
+    // Send join acknowledgment
+    nlohmann::json response = {
+        {"type", "join_ack"},
+        {"payload", {
+            {"player_id", player_id},
+            {"seat", player->seat}
+        }}
+    };
+    sendJson(session, std::move(response));
+    return true;
+}
+
+void GameSession::handleAction(const ClientMessage& message, const std::shared_ptr<Transport>& session)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "handleAction: null session");
         return;
     }
 
-    if (!payload.contains("hand_id") || !payload.contains("action") || !payload.contains("amount")) {
+    if (!message.has_hand_id || !message.has_action || !message.has_amount) {
         sendJson(session, createErrorResponse("invalid_input", "Missing required fields (hand_id, action, amount)"));
         return;
     }
-    std::string hand_id = std::move(payload.at("hand_id").get<std::string>());
-    std::string action = std::move(payload.at("action").get<std::string>());
-    int amount = payload.at("amount").get<int>();
-
-    if (action != "fold" && action != "call" && action != "raise") {
+    if (!message.action) {
         sendJson(session, createErrorResponse("invalid_action", "Action must be fold, call, or raise"));
         return;
     }
+    Action action = *message.action;
+    int amount = message.amount;
     if (amount < 0) {
         sendJson(session, createErrorResponse("invalid_amount", "Amount cannot be negative"));
         return;
@@ -658,7 +840,6 @@ void GameSession::handleAction(const nlohmann::json& payload, std::shared_ptr<We
     // Get player_id from session
     std::string player_id;
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
         auto it = session_to_player_.find(session);
         if (it == session_to_player_.end())
         {
@@ -670,22 +851,32 @@ void GameSession::handleAction(const nlohmann::json& payload, std::shared_ptr<We
 
     // Validate hand_id matches current hand
     const Hand* current_hand = table_manager_.getCurrentHand();
-    if (!current_hand || current_hand->id != hand_id)
+    if (!current_hand || !message.hand_id || *message.hand_id != current_hand->id)
     {
         sendJson(session, createErrorResponse("invalid_hand", "No active hand or hand mismatch"));
         return;
     }
 
-    // Process action via table manager
-    bool success = table_manager_.processPlayerAction(player_id, action, amount);
-    if (!success)
+    if (!applyPlayerAction(player_id, action, amount))
     {
-        common::log::log(common::log::Level::WARN, "Invalid action: " + action + " by player: " + player_id + " amount: " + std::to_string(amount));
+        common::log::log(common::log::Level::WARN, "Invalid action: " + std::string(actionName(action)) + " by player: " + player_id + " amount: " + std::to_string(amount));
         sendJson(session, createErrorResponse("invalid_action", "Action not allowed"));
-        return;
     }
+}
+
+bool GameSession::applyPlayerAction(const std::string& player_id, Action action, int amount)
+{
+    // Process action via table manager
+    if (!table_manager_.processPlayerAction(player_id, action, amount))
+    {
+        return false;
+    }
+
+    const Hand* hand = table_manager_.getCurrentHand();
+    common::log::log(common::log::Level::INFO, "Action processed: " + std::string(actionName(action)) + " by player: " + player_id + " amount: " + std::to_string(amount) + " hand_id: " + poker::formatHandId(hand->id));
 
-    common::log::log(common::log::Level::INFO, "Action processed: " + action + " by player: " + player_id + " amount: " + std::to_string(amount) + " hand_id: " + hand_id);
+    // The player answered in time; the next request re-arms the clock
+    cancelActionTimer();
 
     // Action succeeded, broadcast action_applied
     broadcastActionApplied(player_id, action, amount);
@@ -701,13 +892,16 @@ void GameSession::handleAction(const nlohmann::json& payload, std::shared_ptr<We
 
     // Check if hand is complete
     if (hand_after && poker::isHandComplete(*hand_after)) {
-        common::log::log(common::log::Level::INFO, "Hand completed: " + hand_after->id);
+        common::log::log(common::log::Level::INFO, "Hand completed: " + poker::formatHandId(hand_after->id));
+        cancelActionTimer();
+        metrics::increment(metrics::Counter::HANDS_COMPLETED);
         broadcastHandCompleted();
         table_manager_.endHand();
     }
+    return true;
 }
 
-void GameSession::handlePing(std::shared_ptr<WebSocketSession> session)
+void GameSession::handlePing(const ClientMessage&, const std::shared_ptr<Transport>& session)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "handlePing: null session");
@@ -717,10 +911,10 @@ void GameSession::handlePing(std::shared_ptr<WebSocketSession> session)
         {"type", "pong"},
         {"payload", {}}
     };
-    sendJson(session, pong);
+    sendJson(session, std::move(pong));
 }
 
-void GameSession::handleTopUp(const nlohmann::json& payload, std::shared_ptr<WebSocketSession> session)
+void GameSession::handleTopUp(const ClientMessage&, const std::shared_ptr<Transport>& session)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "handleTopUp: null session");
@@ -730,7 +924,6 @@ void GameSession::handleTopUp(const nlohmann::json& payload, std::shared_ptr<Web
     // Get player_id from session
     std::string player_id;
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
         auto it = session_to_player_.find(session);
         if (it == session_to_player_.end())
         {
@@ -758,31 +951,38 @@ void GameSession::handleTopUp(const nlohmann::json& payload, std::shared_ptr<Web
             {"new_stack", player->stack}
         }}
     };
-    sendJson(session, ack);
+    sendJson(session, std::move(ack));
 }
 
-void GameSession::sendJson(std::shared_ptr<WebSocketSession> session, const nlohmann::json& json)
+void GameSession::sendJson(std::shared_ptr<Transport> session, nlohmann::json json)
 {
     if (!session) {
         common::log::log(common::log::Level::ERROR, "sendJson: null session");
         return;
     }
-    session->send(json.dump());
+    json["table_id"] = tableId();
+    std::string text;
+    {
+        metrics::Serializing serializing;
+        text = json.dump();
+    }
+    session->send(std::move(text));
 }
 
-void GameSession::broadcastJson(const nlohmann::json& json)
+void GameSession::broadcastJson(nlohmann::json json)
 {
-    std::string message = json.dump();
-    std::vector<std::shared_ptr<WebSocketSession>> sessions_copy;
+    json["table_id"] = tableId();
+    Transport::Payload message;
     {
-        std::lock_guard<std::mutex> lock(sessions_mutex_);
-        sessions_copy.reserve(player_sessions_.size());
-        for (const auto& pair : player_sessions_)
-        {
-            sessions_copy.push_back(pair.second);
-        }
+        metrics::Serializing serializing;
+        message = std::make_shared<const std::string>(json.dump());
     }
-    for (const auto& session : sessions_copy)
+    broadcastPayload(message);
+}
+
+void GameSession::broadcastPayload(const Transport::Payload& message)
+{
+    for (const auto& [player_id, session] : player_sessions_)
     {
         if (session)
         {
@@ -1,62 +1,140 @@
 #pragma once
 
 #include "table_manager.hpp"
-#include "websocket_session.hpp"
+#include "transport.hpp"
+#include "client_message.hpp"
 #include "connection_manager.hpp"
 #include "player_state.hpp"
+#include "timing_wheel.hpp"
 #include "../common/json_serialization.hpp"
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <mutex>
+#include <string>
+#include <vector>
 #include <boost/asio.hpp>
 
-namespace beast = boost::beast;
-namespace websocket = beast::websocket;
-namespace net = boost::asio;
-using tcp = net::ip::tcp;
-
-class GameSession : public std::enable_shared_from_this<GameSession> {
+class PreflopEquityTable;
+
+// One heads-up table and the connections seated at it. Every message it sends
+// carries the table's id in a top-level "table_id" field.
+//
+// Table state is owned by the table's strand: the connection entry points below
+// post their work onto it, and the table's timers complete on it, so tables on a
+// multithreaded io_context run in parallel without locking each other out.
+// Everything else must be called from the strand.
+//
+// The player asked to act has action_timeout_ms to answer; when it runs out they
+// check if nothing is owed and fold otherwise, so a stalled client cannot hold
+// the table. Action and disconnection deadlines share one timing wheel.
+class GameSession : public ConnectionHandler, public std::enable_shared_from_this<GameSession> {
 public:
     GameSession(boost::asio::io_context& ioc, int action_timeout_ms = 30000, int disconnect_grace_time_ms = 30000, int removal_timeout_ms = 60000);
 
-    // Handle incoming message from a WebSocket connection
-    void handleMessage(const std::string& message, std::shared_ptr<WebSocketSession> session);
+    // Table whose deadlines are armed on a shared wheel (see TimingWheelPool)
+    GameSession(boost::asio::io_context& ioc, std::shared_ptr<TimingWheel> timing_wheel, int action_timeout_ms = 30000,
+                int disconnect_grace_time_ms = 30000, int removal_timeout_ms = 60000);
+    ~GameSession() override;
+
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    // Executor that serializes this table's work
+    const Strand& strand() const { return strand_; }
+
+    // Handle incoming message from a client connection
+    void handleMessage(std::string_view message, std::shared_ptr<Transport> session) override;
+
+    // Handle a message already parsed by the caller (the table registry parses once to route)
+    void handleClientMessage(ClientMessage message, std::shared_ptr<Transport> session);
 
     // Send welcome message to a newly connected client
-    void sendWelcome(std::shared_ptr<WebSocketSession> session);
+    void sendWelcome(std::shared_ptr<Transport> session) override;
+
+    // Welcome envelope for player_id; table_id is null before the player is routed to a table
+    static nlohmann::json welcomeMessage(const std::string& player_id, const nlohmann::json& table_id);
 
     // Send hand_started message to all connected clients
     void broadcastHandStarted();
 
-    // Send action_request to specific player
+    // Send action_request to specific player and start their action timeout
     void sendActionRequest(const std::string& player_id);
 
     // Send action_applied to all clients
-    void broadcastActionApplied(const std::string& player_id, const std::string& action, int amount);
+    void broadcastActionApplied(const std::string& player_id, Action action, int amount);
 
     // Send hand_completed to all clients
     void broadcastHandCompleted();
 
-    // Register a WebSocket session for a player
-    void registerSession(const std::string& player_id, std::shared_ptr<WebSocketSession> session);
+    // Hold a seat for a join routed here but not yet run; false if no seat is free.
+    // Safe from any thread.
+    bool reserveSeat();
+
+    // handleMessage for a join holding a reservation; the reservation is released
+    // in the same snapshot update that shows the join's result
+    void handleReservedJoin(ClientMessage message, std::shared_ptr<Transport> session);
+
+    // handleMessage for a join the registry routed here to reclaim a seat. It never
+    // seats a new player: if the seat cannot be reclaimed the join gets an error
+    // and the session is forgotten. The reconnect handler hears the outcome.
+    void handleReconnectJoin(ClientMessage message, std::shared_ptr<Transport> session);
+
+    // Register a client transport for a player (posted to the strand like the entry points)
+    void registerSession(const std::string& player_id, std::shared_ptr<Transport> session);
 
     // Remove a session (on disconnect)
     void removeSession(const std::string& player_id);
 
-    // Handle WebSocket disconnection
-    void onDisconnect(std::shared_ptr<WebSocketSession> session);
+    // Handle client disconnection
+    void onDisconnect(std::shared_ptr<Transport> session) override;
+
+    // Called on the strand when the disconnection timers remove a player. Set
+    // before the table is shared.
+    void setPlayerRemovedHandler(std::function<void(const std::string&)> handler);
+
+    // Called on the strand with the outcome of each handleReconnectJoin. Set
+    // before the table is shared.
+    using ReconnectHandler = std::function<void(const std::shared_ptr<Transport>& session, const std::string& player_id, bool accepted)>;
+    void setReconnectHandler(ReconnectHandler handler);
+
+    // Equities reported in hand_completed; none are reported without a table.
+    // Set before the table is shared.
+    void setPreflopTable(std::shared_ptr<const PreflopEquityTable> preflop_table);
+
+    // Log the deck seed for replay (see TableManager::logDeckSeed). Call before
+    // the table is shared.
+    void logDeckSeed() const { table_manager_.logDeckSeed(); }
+
+    // Table state for routing and reporting. These read a snapshot published at the
+    // end of each unit of strand work, so they are safe from any thread.
+    const std::string& tableId() const { return table_manager_.getTable().id; }
+    int seatedPlayers() const;
+    bool hasActiveHand() const;
+    // Bytes held by this table, its seated players and its session maps as of the
+    // last snapshot. A lower bound: allocator overhead, shared_ptr control blocks,
+    // armed timers and the connections' own buffers are not counted.
+    std::size_t stateBytes() const;
+    bool isSeated(const std::string& player_id) const;
+    // Seated but disconnected, so a join naming the player may take the seat back
+    bool awaitsReconnect(const std::string& player_id) const;
 
 private:
     TableManager table_manager_;
-    mutable std::mutex sessions_mutex_;
-    std::unordered_map<std::string, std::shared_ptr<WebSocketSession>> player_sessions_;
-    std::unordered_map<std::shared_ptr<WebSocketSession>, std::string> session_to_player_;
+    Strand strand_;
+    std::unordered_map<std::string, std::shared_ptr<Transport>> player_sessions_;
+    std::unordered_map<std::shared_ptr<Transport>, std::string> session_to_player_;
 
     // Timeout configuration (milliseconds)
     int action_timeout_ms_;
     int disconnect_grace_time_ms_;
     int removal_timeout_ms_;
 
+    // Deadlines for the whole table
+    std::shared_ptr<TimingWheel> timing_wheel_;
+    TimingWheel::Handle action_timer_;
+    std::uint64_t action_timer_id_ = 0; // bumped on every arm and cancel; stale expiries see a different id
+
     // Disconnection handling
     boost::asio::io_context& ioc_;
     ConnectionManager connection_manager_;
@@ -65,17 +143,31 @@ private:
     // Generate a unique player ID for new connections
     std::string generatePlayerId();
 
-    // Handle specific message types
-    void handleJoin(const nlohmann::json& payload, std::shared_ptr<WebSocketSession> session);
-    void handleAction(const nlohmann::json& payload, std::shared_ptr<WebSocketSession> session);
-    void handlePing(std::shared_ptr<WebSocketSession> session);
-    void handleTopUp(const nlohmann::json& payload, std::shared_ptr<WebSocketSession> session);
+    // Handle specific message types; indexed by ClientMessageType in doHandleMessage
+    using MessageHandler = void (GameSession::*)(const ClientMessage& message, const std::shared_ptr<Transport>& session);
+    void handleJoin(const ClientMessage& message, const std::shared_ptr<Transport>& session);
+    void handleAction(const ClientMessage& message, const std::shared_ptr<Transport>& session);
+    void handlePing(const ClientMessage& message, const std::shared_ptr<Transport>& session);
+    void handleTopUp(const ClientMessage& message, const std::shared_ptr<Transport>& session);
+
+    // Apply a validated action for player_id and move the hand on: broadcast it,
+    // ask the next player, and complete the hand if it is over. False if the
+    // table rejects the action.
+    bool applyPlayerAction(const std::string& player_id, Action action, int amount);
 
-    // Send JSON message to a session
-    void sendJson(std::shared_ptr<WebSocketSession> session, const nlohmann::json& json);
+    // Action timeout for the player asked to act
+    void armActionTimer();
+    void cancelActionTimer();
+    void onActionTimeout(std::uint64_t timer_id);
 
-    // Broadcast JSON message to all connected sessions
-    void broadcastJson(const nlohmann::json& json);
+    // Send JSON message to a session (table_id is added to the envelope)
+    void sendJson(std::shared_ptr<Transport> session, nlohmann::json json);
+
+    // Broadcast JSON message to all connected sessions (table_id is added to the envelope)
+    void broadcastJson(nlohmann::json json);
+
+    // Broadcast an already serialized message (see message_writer.hpp) to all connected sessions
+    void broadcastPayload(const Transport::Payload& message);
 
     // Broadcast player_removed message
     void broadcastPlayerRemoved(const std::string& player_id);
@@ -84,4 +176,30 @@ private:
     void broadcastPlayerReconnected(const std::string& player_id);
 
     nlohmann::json createErrorResponse(const std::string& code, const std::string& message) const;
+
+    // Strand-side bodies of the connection entry points
+    void doHandleMessage(const ClientMessage& message, const std::shared_ptr<Transport>& session);
+    void doSendWelcome(const std::shared_ptr<Transport>& session);
+    void doOnDisconnect(const std::shared_ptr<Transport>& session);
+    void onPlayerRemoved(const std::string& player_id);
+    // Attach session to a seated player waiting to reconnect and acknowledge the join.
+    // False, with nothing sent, if the player is not waiting or another session holds them.
+    bool reconnectPlayer(const std::string& player_id, const std::shared_ptr<Transport>& session);
+
+    // Copy seat and hand state into the snapshot read by other threads
+    void publishSnapshot(int released_reservations = 0);
+
+    struct Snapshot {
+        std::vector<std::string> seated_ids;
+        std::vector<bool> awaiting_reconnect; // aligned with seated_ids
+        int reserved_seats = 0;
+        bool hand_active = false;
+        std::size_t state_bytes = 0;
+    };
+    mutable std::mutex snapshot_mutex_;
+    Snapshot snapshot_;
+
+    std::function<void(const std::string&)> player_removed_handler_;
+    ReconnectHandler reconnect_handler_;
+    std::shared_ptr<const PreflopEquityTable> preflop_table_;
 };
@@ -0,0 +1,190 @@
+#include "heartbeat_sweeper.hpp"
+#include <algorithm>
+
+HeartbeatSweeper::Peer::~Peer()
+{
+    if (sweeper_)
+    {
+        sweeper_->leave(*this);
+    }
+}
+
+HeartbeatSweeper::HeartbeatSweeper(boost::asio::io_context& ioc, std::chrono::milliseconds interval,
+                                   std::chrono::milliseconds pong_timeout, std::size_t buckets)
+    : strand_(boost::asio::make_strand(ioc)),
+      tick_timer_(strand_),
+      heads_(std::max<std::size_t>(buckets, 2), nullptr),
+      counts_(heads_.size(), 0)
+{
+    tick_ = std::max<std::chrono::steady_clock::duration>(
+        std::chrono::steady_clock::duration(interval) / static_cast<int>(heads_.size()), std::chrono::milliseconds(1));
+    // Rounded up so a check never comes before the timeout, and kept short of a
+    // full lap so it comes before the next ping
+    auto lag = (pong_timeout + tick_ - std::chrono::steady_clock::duration(1)) / tick_;
+    check_lag_ = std::clamp<std::size_t>(static_cast<std::size_t>(std::max<decltype(lag)>(lag, 1)), 1, heads_.size() - 1);
+}
+
+HeartbeatSweeper::~HeartbeatSweeper()
+{
+    boost::system::error_code ec;
+    tick_timer_.cancel(ec);
+}
+
+void HeartbeatSweeper::join(const std::shared_ptr<Peer>& peer)
+{
+    bool start = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (peer->sweeper_)
+        {
+            return;
+        }
+        // Least loaded bucket; ties go to the one pinged longest from now, so an
+        // even spread gives a new peer a full interval before its first ping
+        std::size_t best = cursor_;
+        for (std::size_t i = 1; i < heads_.size(); ++i)
+        {
+            std::size_t bucket = (cursor_ + heads_.size() - i) % heads_.size();
+            if (counts_[bucket] < counts_[best])
+            {
+                best = bucket;
+            }
+        }
+
+        peer->sweeper_ = shared_from_this();
+        peer->self_ = peer;
+        peer->bucket_ = best;
+        peer->prev_ = nullptr;
+        peer->next_ = heads_[best];
+        if (peer->next_)
+        {
+            peer->next_->prev_ = peer.get();
+        }
+        heads_[best] = peer.get();
+        ++counts_[best];
+        ++size_;
+
+        if (!ticking_)
+        {
+            ticking_ = true;
+            start = true;
+        }
+    }
+    if (start)
+    {
+        startTicking();
+    }
+}
+
+void HeartbeatSweeper::leave(Peer& peer)
+{
+    std::shared_ptr<HeartbeatSweeper> keep_alive; // released after the lock
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (peer.sweeper_.get() != this)
+    {
+        return;
+    }
+    unlink(peer);
+    keep_alive = std::move(peer.sweeper_);
+    peer.self_.reset();
+}
+
+void HeartbeatSweeper::unlink(Peer& peer)
+{
+    if (peer.prev_)
+    {
+        peer.prev_->next_ = peer.next_;
+    }
+    else
+    {
+        heads_[peer.bucket_] = peer.next_;
+    }
+    if (peer.next_)
+    {
+        peer.next_->prev_ = peer.prev_;
+    }
+    peer.prev_ = nullptr;
+    peer.next_ = nullptr;
+    --counts_[peer.bucket_];
+    --size_;
+}
+
+std::size_t HeartbeatSweeper::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+void HeartbeatSweeper::sweep()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cursor_ = (cursor_ + 1) % heads_.size();
+        std::size_t check = (cursor_ + heads_.size() - check_lag_) % heads_.size();
+        // A peer whose destructor is waiting on the lock no longer locks
+        for (Peer* peer = heads_[cursor_]; peer; peer = peer->next_)
+        {
+            if (auto self = peer->self_.lock())
+            {
+                to_ping_.push_back(std::move(self));
+            }
+        }
+        for (Peer* peer = heads_[check]; peer; peer = peer->next_)
+        {
+            if (auto self = peer->self_.lock())
+            {
+                to_check_.push_back(std::move(self));
+            }
+        }
+    }
+
+    for (const auto& peer : to_check_)
+    {
+        peer->checkHeartbeat();
+    }
+    for (const auto& peer : to_ping_)
+    {
+        peer->sendHeartbeat();
+    }
+    // Dropped outside the lock: the last reference may destroy a peer, which leaves
+    to_check_.clear();
+    to_ping_.clear();
+}
+
+void HeartbeatSweeper::startTicking()
+{
+    boost::asio::post(strand_, [weak_self = weak_from_this()]() {
+        if (auto self = weak_self.lock())
+        {
+            self->tick_timer_.expires_after(self->tick_);
+            self->armTick();
+        }
+    });
+}
+
+void HeartbeatSweeper::armTick()
+{
+    tick_timer_.async_wait([weak_self = weak_from_this()](const boost::system::error_code& ec) {
+        if (ec)
+        {
+            return;
+        }
+        auto self = weak_self.lock();
+        if (!self)
+        {
+            return;
+        }
+        self->sweep();
+        {
+            std::lock_guard<std::mutex> lock(self->mutex_);
+            if (self->size_ == 0)
+            {
+                self->ticking_ = false;
+                return;
+            }
+        }
+        // From the last deadline rather than now, so the sweep does not drift
+        self->tick_timer_.expires_at(self->tick_timer_.expiry() + self->tick_);
+        self->armTick();
+    });
+}
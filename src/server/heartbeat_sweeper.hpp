@@ -0,0 +1,89 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Keep-alive for many connections on one timer. The ping interval is cut into
+// buckets, each an intrusive list of connections; every tick pings one bucket
+// and checks the bucket that was pinged a pong timeout ago, so a connection is
+// pinged once per interval and checked once per ping, and the wakeups per
+// interval are the bucket count however many connections there are.
+// Connections join the least loaded bucket, which spreads pings evenly even
+// when connections arrive in a burst.
+//
+// join() and leave() are safe from any thread; sweeps run on the sweeper's own
+// strand and only hand work to the connections.
+class HeartbeatSweeper : public std::enable_shared_from_this<HeartbeatSweeper> {
+public:
+    static constexpr std::size_t DEFAULT_BUCKETS = 32;
+
+    // A connection kept alive by a sweeper. Both calls come from the sweeper's
+    // strand, so implementations post to their own executor. A peer leaves its
+    // sweeper when it is destroyed.
+    class Peer {
+    public:
+        virtual ~Peer();
+
+        // Send a ping
+        virtual void sendHeartbeat() = 0;
+
+        // The pong timeout has passed since the last sendHeartbeat (or, for a peer
+        // that has not been pinged yet, since some earlier point)
+        virtual void checkHeartbeat() = 0;
+
+    private:
+        friend class HeartbeatSweeper;
+        std::shared_ptr<HeartbeatSweeper> sweeper_;
+        std::weak_ptr<Peer> self_;
+        Peer* prev_ = nullptr;
+        Peer* next_ = nullptr;
+        std::size_t bucket_ = 0;
+    };
+
+    HeartbeatSweeper(boost::asio::io_context& ioc, std::chrono::milliseconds interval,
+                     std::chrono::milliseconds pong_timeout, std::size_t buckets = DEFAULT_BUCKETS);
+    ~HeartbeatSweeper();
+
+    HeartbeatSweeper(const HeartbeatSweeper&) = delete;
+    HeartbeatSweeper& operator=(const HeartbeatSweeper&) = delete;
+
+    // Start pinging peer; a peer belongs to at most one sweeper
+    void join(const std::shared_ptr<Peer>& peer);
+
+    // Stop pinging peer; no-op if it is not a member
+    void leave(Peer& peer);
+
+    // Connections currently members
+    std::size_t size() const;
+
+    // Advance one bucket. The tick timer calls this; it is public so benchmarks
+    // can sweep without waiting out the interval.
+    void sweep();
+
+private:
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    void unlink(Peer& peer);
+    void startTicking();
+    void armTick();
+
+    Strand strand_;
+    boost::asio::steady_timer tick_timer_;
+    std::chrono::steady_clock::duration tick_;
+    std::size_t check_lag_; // buckets between a ping and its check
+
+    mutable std::mutex mutex_;
+    std::vector<Peer*> heads_;
+    std::vector<std::size_t> counts_;
+    std::size_t cursor_ = 0; // bucket pinged by the last sweep
+    std::size_t size_ = 0;
+    bool ticking_ = false;
+
+    // Batches taken under the lock and handed out after it is released; sweep only
+    std::vector<std::shared_ptr<Peer>> to_ping_;
+    std::vector<std::shared_ptr<Peer>> to_check_;
+};
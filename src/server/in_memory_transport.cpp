@@ -0,0 +1,80 @@
+#include "in_memory_transport.hpp"
+#include "../common/logging.hpp"
+
+void InMemoryTransport::send(Payload message)
+{
+    if (!message || message->empty()) {
+        common::log::log(common::log::Level::WARN, "InMemoryTransport::send: empty message");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(outbox_mutex_);
+    outbox_.push_back(std::move(message));
+}
+
+void InMemoryTransport::setHandler(std::shared_ptr<ConnectionHandler> handler)
+{
+    handler_ = handler;
+}
+
+void InMemoryTransport::start()
+{
+    if (auto handler = handler_.lock())
+    {
+        handler->sendWelcome(shared_from_this());
+    }
+}
+
+void InMemoryTransport::deliver(const std::string& message)
+{
+    if (auto handler = handler_.lock())
+    {
+        handler->handleMessage(message, shared_from_this());
+    }
+}
+
+void InMemoryTransport::close()
+{
+    if (auto handler = handler_.lock())
+    {
+        handler->onDisconnect(shared_from_this());
+    }
+}
+
+bool InMemoryTransport::receive(std::string& message)
+{
+    std::lock_guard<std::mutex> lock(outbox_mutex_);
+    if (outbox_.empty())
+    {
+        return false;
+    }
+    message = *outbox_.front();
+    outbox_.pop_front();
+    return true;
+}
+
+std::vector<std::string> InMemoryTransport::drain()
+{
+    std::lock_guard<std::mutex> lock(outbox_mutex_);
+    std::vector<std::string> messages;
+    messages.reserve(outbox_.size());
+    for (const Payload& payload : outbox_)
+    {
+        messages.push_back(*payload);
+    }
+    outbox_.clear();
+    return messages;
+}
+
+std::vector<InMemoryTransport::Payload> InMemoryTransport::drainPayloads()
+{
+    std::lock_guard<std::mutex> lock(outbox_mutex_);
+    std::vector<Payload> payloads(std::make_move_iterator(outbox_.begin()), std::make_move_iterator(outbox_.end()));
+    outbox_.clear();
+    return payloads;
+}
+
+std::size_t InMemoryTransport::pending() const
+{
+    std::lock_guard<std::mutex> lock(outbox_mutex_);
+    return outbox_.size();
+}
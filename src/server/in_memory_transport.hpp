@@ -0,0 +1,46 @@
+#pragma once
+
+#include "transport.hpp"
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Transport whose client lives in the same process. Server messages collect in
+// an outbox for the client to take; client messages are handed straight to the
+// handler on the calling thread, as WebSocketSession does after a read.
+class InMemoryTransport : public Transport, public std::enable_shared_from_this<InMemoryTransport> {
+public:
+    using Transport::send;
+    void send(Payload message) override;
+
+    // Set the handler (a table or the table registry) for incoming messages
+    void setHandler(std::shared_ptr<ConnectionHandler> handler);
+
+    // Connection accepted: the handler sends its welcome
+    void start();
+
+    // Client to server message
+    void deliver(const std::string& message);
+
+    // Client went away; the handler starts its disconnect handling
+    void close();
+
+    // Oldest unread server message, if any
+    bool receive(std::string& message);
+
+    // All unread server messages, oldest first
+    std::vector<std::string> drain();
+
+    // As drain(), but hands back the shared buffers themselves rather than copies
+    std::vector<Payload> drainPayloads();
+
+    std::size_t pending() const;
+
+private:
+    std::weak_ptr<ConnectionHandler> handler_;
+    mutable std::mutex outbox_mutex_;
+    std::deque<Payload> outbox_;
+};
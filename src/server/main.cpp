@@ -1,15 +1,22 @@
 #include "server.hpp"
 #include "../common/constants.hpp"
+#include "../core/preflop_table.hpp"
 #include <boost/asio.hpp>
 #include <iostream>
 #include <cstdlib>
 #include <string>
+#include <thread>
+#include <vector>
 
 int main(int argc, char** argv) {
     unsigned short port = 8080;
     int action_timeout_ms = 30000;
     int disconnect_grace_time_ms = 30000;
     int removal_timeout_ms = 60000;
+    std::size_t max_tables = 0;
+    int threads = 1;
+    std::string preflop_table_path;
+    bool replay_log = false;
 
     // Simple argument parsing (supports spec names: ample-time, removal-timeout)
     for (int i = 1; i < argc; ++i) {
@@ -62,9 +69,36 @@ int main(int argc, char** argv) {
                 std::cerr << "Invalid removal timeout value: " << argv[i] << "\n";
                 return 1;
             }
+        } else if (arg == "--max-tables" && i + 1 < argc) {
+            try {
+                int max_tables_value = std::stoi(argv[++i]);
+                if (max_tables_value < 0) {
+                    std::cerr << "Max tables must be 0 (unlimited) or more\n";
+                    return 1;
+                }
+                max_tables = static_cast<std::size_t>(max_tables_value);
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid max tables value: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            try {
+                threads = std::stoi(argv[++i]);
+                if (threads < 1) {
+                    std::cerr << "Threads must be at least 1\n";
+                    return 1;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Invalid threads value: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (arg == "--preflop-table" && i + 1 < argc) {
+            preflop_table_path = argv[++i];
+        } else if (arg == "--replay-log") {
+            replay_log = true;
         } else if (arg == "--help") {
-            std::cout << "Usage: " << argv[0] << " [--port <port>] [--ample-time <seconds>] [--removal-timeout <seconds>] [--action-timeout <ms>]\n";
-            std::cout << "Defaults: port=8080, ample-time=30s, removal-timeout=60s, action-timeout=30000ms\n";
+            std::cout << "Usage: " << argv[0] << " [--port <port>] [--ample-time <seconds>] [--removal-timeout <seconds>] [--action-timeout <ms>] [--max-tables <n>] [--threads <n>] [--preflop-table <file>] [--replay-log]\n";
+            std::cout << "Defaults: port=8080, ample-time=30s, removal-timeout=60s, action-timeout=30000ms, max-tables=0 (unlimited), threads=1, preflop-table=none (no equities in hand_completed), replay-log off\n";
             return 0;
         } else {
             std::cerr << "Unknown argument: " << arg << "\n";
@@ -73,10 +107,26 @@ int main(int argc, char** argv) {
     }
 
     try {
-        boost::asio::io_context ioc;
-        Server server(ioc, port, action_timeout_ms, disconnect_grace_time_ms, removal_timeout_ms);
-        std::cout << "Poker server listening on port " << port << "\n";
+        // A table that was asked for but is missing or stale stops the server here
+        std::shared_ptr<const PreflopEquityTable> preflop_table;
+        if (!preflop_table_path.empty()) {
+            preflop_table = std::make_shared<const PreflopEquityTable>(preflop_table_path);
+        }
+        boost::asio::io_context ioc(threads);
+        Server server(ioc, port, action_timeout_ms, disconnect_grace_time_ms, removal_timeout_ms, max_tables,
+                      static_cast<std::size_t>(threads), std::move(preflop_table), replay_log);
+        std::cout << "Poker server listening on port " << port << " (" << threads << " threads)\n";
+        // Tables and connections each run on their own strand, so extra threads
+        // let independent tables make progress in parallel
+        std::vector<std::thread> workers;
+        workers.reserve(static_cast<std::size_t>(threads - 1));
+        for (int t = 1; t < threads; ++t) {
+            workers.emplace_back([&ioc] { ioc.run(); });
+        }
         ioc.run();
+        for (auto& worker : workers) {
+            worker.join();
+        }
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
@@ -0,0 +1,361 @@
+#include "message_writer.hpp"
+#include "metrics.hpp"
+#include "../core/hand.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+
+void JsonWriter::separate()
+{
+    if (after_key_)
+    {
+        after_key_ = false;
+        return;
+    }
+    if (!first_)
+    {
+        out_ += ',';
+    }
+    first_ = false;
+}
+
+void JsonWriter::beginObject()
+{
+    separate();
+    out_ += '{';
+    first_ = true;
+}
+
+void JsonWriter::endObject()
+{
+    out_ += '}';
+    first_ = false;
+}
+
+void JsonWriter::beginArray()
+{
+    separate();
+    out_ += '[';
+    first_ = true;
+}
+
+void JsonWriter::endArray()
+{
+    out_ += ']';
+    first_ = false;
+}
+
+void JsonWriter::key(std::string_view name)
+{
+    separate();
+    string(name);
+    out_ += ':';
+    after_key_ = true;
+}
+
+void JsonWriter::value(std::string_view text)
+{
+    separate();
+    string(text);
+}
+
+void JsonWriter::value(int64_t number)
+{
+    separate();
+    std::array<char, 24> digits;
+    auto result = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+    out_.append(digits.data(), static_cast<std::size_t>(result.ptr - digits.data()));
+}
+
+void JsonWriter::value(double number)
+{
+    if (!std::isfinite(number))
+    {
+        null();
+        return;
+    }
+    separate();
+    // Shortest round-trip digits, which is what dump() prints too
+    std::array<char, 32> digits;
+    auto result = std::to_chars(digits.data(), digits.data() + digits.size(), number, std::chars_format::fixed);
+    std::string_view text(digits.data(), static_cast<std::size_t>(result.ptr - digits.data()));
+    out_ += text;
+    // dump() marks whole numbers as floating point
+    if (text.find('.') == std::string_view::npos)
+    {
+        out_ += ".0";
+    }
+}
+
+void JsonWriter::null()
+{
+    separate();
+    out_ += "null";
+}
+
+void JsonWriter::string(std::string_view text)
+{
+    static constexpr char HEX[] = "0123456789abcdef";
+    out_ += '"';
+    for (char c : text)
+    {
+        auto byte = static_cast<unsigned char>(c);
+        switch (c)
+        {
+            case '"': out_ += "\\\""; break;
+            case '\\': out_ += "\\\\"; break;
+            case '\b': out_ += "\\b"; break;
+            case '\f': out_ += "\\f"; break;
+            case '\n': out_ += "\\n"; break;
+            case '\r': out_ += "\\r"; break;
+            case '\t': out_ += "\\t"; break;
+            default:
+                if (byte < 0x20)
+                {
+                    out_ += "\\u00";
+                    out_ += HEX[byte >> 4];
+                    out_ += HEX[byte & 0x0f];
+                }
+                else
+                {
+                    out_ += c;
+                }
+        }
+    }
+    out_ += '"';
+}
+
+namespace {
+
+// Scratch space for one message; keeps its capacity between messages on a thread
+std::string& scratch()
+{
+    thread_local std::string buffer;
+    buffer.clear();
+    return buffer;
+}
+
+void handId(JsonWriter& writer, uint64_t id)
+{
+    // Same text as poker::formatHandId, written in place without a temporary string
+    std::array<char, poker::HAND_ID_LENGTH> text;
+    poker::writeHandId(id, text.data());
+    writer.key("hand_id");
+    writer.value(std::string_view(text.data(), text.size()));
+}
+
+// Keys sort as payload < table_id < type, so the envelope closes after the payload
+Transport::Payload finish(JsonWriter& writer, std::string& buffer, const std::string& table_id, std::string_view type)
+{
+    writer.key("table_id");
+    writer.value(table_id);
+    writer.key("type");
+    writer.value(type);
+    writer.endObject();
+    return std::make_shared<const std::string>(buffer);
+}
+
+} // anonymous namespace
+
+namespace messages {
+
+Transport::Payload handStarted(const std::string& table_id, uint64_t hand_id, span<Player* const> players,
+                               int small_blind, int big_blind, int dealer_position,
+                               const std::string& current_player_to_act, int min_raise)
+{
+    metrics::Serializing serializing;
+    std::string& buffer = scratch();
+    JsonWriter writer(buffer);
+    writer.beginObject();
+    writer.key("payload");
+    writer.beginObject();
+    writer.key("big_blind");
+    writer.value(big_blind);
+    writer.key("current_player_to_act");
+    writer.value(current_player_to_act);
+    writer.key("dealer_position");
+    writer.value(dealer_position);
+    handId(writer, hand_id);
+    writer.key("min_raise");
+    writer.value(min_raise);
+    writer.key("players");
+    writer.beginArray();
+    for (const Player* player : players)
+    {
+        if (!player)
+        {
+            continue;
+        }
+        writer.beginObject();
+        writer.key("hole_cards");
+        writer.beginArray();
+        for (const Card& card : player->hole_cards)
+        {
+            writer.value(card.toString());
+        }
+        writer.endArray();
+        writer.key("player_id");
+        writer.value(player->id);
+        writer.key("stack");
+        writer.value(player->stack);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.key("small_blind");
+    writer.value(small_blind);
+    writer.endObject();
+    return finish(writer, buffer, table_id, "hand_started");
+}
+
+Transport::Payload actionRequest(const std::string& table_id, uint64_t hand_id, int call_amount, int min_raise,
+                                 int max_raise, int timeout_ms)
+{
+    metrics::Serializing serializing;
+    std::string& buffer = scratch();
+    JsonWriter writer(buffer);
+    writer.beginObject();
+    writer.key("payload");
+    writer.beginObject();
+    writer.key("call_amount");
+    writer.value(call_amount);
+    handId(writer, hand_id);
+    writer.key("max_raise");
+    writer.value(max_raise);
+    writer.key("min_raise");
+    writer.value(min_raise);
+    writer.key("possible_actions");
+    writer.beginArray();
+    writer.value(actionName(Action::FOLD));
+    writer.value(actionName(Action::CALL));
+    writer.value(actionName(Action::RAISE));
+    writer.endArray();
+    writer.key("timeout_ms");
+    writer.value(timeout_ms);
+    writer.endObject();
+    return finish(writer, buffer, table_id, "action_request");
+}
+
+Transport::Payload actionApplied(const std::string& table_id, uint64_t hand_id, const std::string& player_id,
+                                 Action action, int amount, int new_stack, int pot,
+                                 const std::string& next_player_to_act)
+{
+    metrics::Serializing serializing;
+    std::string& buffer = scratch();
+    JsonWriter writer(buffer);
+    writer.beginObject();
+    writer.key("payload");
+    writer.beginObject();
+    writer.key("action");
+    writer.value(actionName(action));
+    writer.key("amount");
+    writer.value(amount);
+    handId(writer, hand_id);
+    writer.key("new_stack");
+    writer.value(new_stack);
+    writer.key("next_player_to_act");
+    writer.value(next_player_to_act);
+    writer.key("player_id");
+    writer.value(player_id);
+    writer.key("pot");
+    writer.value(pot);
+    writer.endObject();
+    return finish(writer, buffer, table_id, "action_applied");
+}
+
+Transport::Payload handCompleted(const std::string& table_id, uint64_t hand_id, span<const Winner> winners,
+                                 span<Player* const> players, span<const AllInEquity> equities)
+{
+    metrics::Serializing serializing;
+    std::string& buffer = scratch();
+    JsonWriter writer(buffer);
+    writer.beginObject();
+    writer.key("payload");
+    writer.beginObject();
+    if (!equities.empty())
+    {
+        std::array<const AllInEquity*, common::constants::MAX_SEATS> by_id{};
+        std::size_t count = 0;
+        for (const AllInEquity& equity : equities)
+        {
+            if (count < by_id.size())
+            {
+                by_id[count++] = &equity;
+            }
+        }
+        std::sort(by_id.begin(), by_id.begin() + count,
+                  [](const AllInEquity* a, const AllInEquity* b) { return *a->player_id < *b->player_id; });
+        writer.key("all_in_equity");
+        writer.beginObject();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            writer.key(*by_id[i]->player_id);
+            writer.beginObject();
+            writer.key("equity");
+            writer.value(by_id[i]->equity);
+            writer.key("ev");
+            writer.value(by_id[i]->ev);
+            writer.endObject();
+        }
+        writer.endObject();
+    }
+    handId(writer, hand_id);
+    writer.key("pot_distribution");
+    writer.beginArray();
+    for (const Winner& winner : winners)
+    {
+        writer.beginObject();
+        writer.key("amount");
+        writer.value(winner.amount);
+        writer.key("pot_index");
+        writer.value(0);
+        writer.key("winner_id");
+        writer.value(*winner.player_id);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    // An object keyed by player id: sorted, and a repeated id keeps its last stack
+    std::array<const Player*, common::constants::MAX_SEATS> sorted{};
+    std::size_t count = 0;
+    for (const Player* player : players)
+    {
+        if (player && count < sorted.size())
+        {
+            sorted[count++] = player;
+        }
+    }
+    std::stable_sort(sorted.begin(), sorted.begin() + count,
+                     [](const Player* a, const Player* b) { return a->id < b->id; });
+    writer.key("updated_stacks");
+    writer.beginObject();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i + 1 < count && sorted[i + 1]->id == sorted[i]->id)
+        {
+            continue;
+        }
+        writer.key(sorted[i]->id);
+        writer.value(sorted[i]->stack);
+    }
+    writer.endObject();
+
+    writer.key("winners");
+    writer.beginArray();
+    for (const Winner& winner : winners)
+    {
+        writer.beginObject();
+        writer.key("amount_won");
+        writer.value(winner.amount);
+        writer.key("hand_rank");
+        writer.value("unknown");
+        writer.key("player_id");
+        writer.value(*winner.player_id);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+    return finish(writer, buffer, table_id, "hand_completed");
+}
+
+} // namespace messages
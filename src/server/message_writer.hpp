@@ -0,0 +1,80 @@
+#pragma once
+
+#include "transport.hpp"
+#include "../core/betting_rules.hpp"
+#include "../core/models/player.hpp"
+#include "../core/span.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Appends compact JSON to a string, producing the same bytes as
+// nlohmann::json::dump() for the same document. nlohmann objects keep their keys
+// sorted, so callers must write keys in sorted order. Strings are escaped like
+// dump(); they are assumed to be valid UTF-8 and are not checked.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(std::string_view name);
+
+    void value(std::string_view text);
+    void value(const char* text) { value(std::string_view(text)); }
+    void value(int64_t number);
+    void value(int number) { value(static_cast<int64_t>(number)); }
+    // Matches dump() for magnitudes from 1e-4 up to 1e15, where it writes fixed
+    // notation; callers round to fit. NaN and infinities are written as null.
+    void value(double number);
+    void null();
+
+private:
+    // Comma before a key or array element, none right after a key
+    void separate();
+    void string(std::string_view text);
+
+    std::string& out_;
+    bool first_ = true;
+    bool after_key_ = false;
+};
+
+// Writers for the server's hot contract messages
+// (specs/001-heads-up-nlhe-bots/contracts/websocket-api.md). Each builds the
+// full envelope, table_id included, in a reusable per-thread buffer and returns
+// it as one payload ready to queue on any number of transports. The output is
+// byte-identical to the nlohmann DOM these messages were built with before.
+namespace messages {
+
+struct Winner {
+    const std::string* player_id;
+    int amount;
+};
+
+Transport::Payload handStarted(const std::string& table_id, uint64_t hand_id, span<Player* const> players,
+                               int small_blind, int big_blind, int dealer_position,
+                               const std::string& current_player_to_act, int min_raise);
+
+Transport::Payload actionRequest(const std::string& table_id, uint64_t hand_id, int call_amount, int min_raise,
+                                 int max_raise, int timeout_ms);
+
+Transport::Payload actionApplied(const std::string& table_id, uint64_t hand_id, const std::string& player_id,
+                                 Action action, int amount, int new_stack, int pot,
+                                 const std::string& next_player_to_act);
+
+// Preflop all-in equity of a player's hole cards against their opponent's, and
+// the chips they would expect to net had the final pot gone in preflop
+struct AllInEquity {
+    const std::string* player_id;
+    double equity;
+    double ev;
+};
+
+// updated_stacks lists every non-null player in players. all_in_equity is left
+// out when equities is empty.
+Transport::Payload handCompleted(const std::string& table_id, uint64_t hand_id, span<const Winner> winners,
+                                 span<Player* const> players, span<const AllInEquity> equities = {});
+
+} // namespace messages
@@ -0,0 +1,676 @@
+#include "metrics.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace metrics {
+
+namespace {
+
+constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(Counter::COUNT);
+constexpr std::size_t HISTOGRAM_COUNT = static_cast<std::size_t>(Histogram::COUNT);
+constexpr std::size_t MAX_BUCKETS = 12; // including +Inf
+
+struct CounterInfo {
+    const char* name;
+    const char* labels;
+    const char* help;
+};
+
+// Counters sharing a name are one labelled family; they must be adjacent
+constexpr std::array<CounterInfo, COUNTER_COUNT> COUNTERS = {{
+    {"poker_connections_opened_total", "", "WebSocket connections accepted"},
+    {"poker_connections_closed_total", "", "WebSocket connections closed or timed out"},
+    {"poker_messages_received_total", "type=\"join\"", "Client messages received, by type"},
+    {"poker_messages_received_total", "type=\"action\"", nullptr},
+    {"poker_messages_received_total", "type=\"ping\"", nullptr},
+    {"poker_messages_received_total", "type=\"top_up\"", nullptr},
+    {"poker_messages_received_total", "type=\"invalid\"", nullptr},
+    {"poker_messages_sent_total", "", "Server messages queued to WebSocket connections"},
+    {"poker_bytes_sent_total", "", "Bytes of server messages queued to WebSocket connections"},
+    {"poker_hands_started_total", "", "Hands started"},
+    {"poker_hands_completed_total", "", "Hands completed"},
+    {"poker_action_timeouts_total", "", "Players checked or folded by the action timeout"},
+    {"poker_allocations_total", "", "Heap allocations through operator new"},
+}};
+
+struct HistogramInfo {
+    const char* name;
+    const char* help;
+    std::array<std::uint64_t, MAX_BUCKETS - 1> bounds; // upper bounds; unused ones are 0
+};
+
+constexpr std::array<HistogramInfo, HISTOGRAM_COUNT> HISTOGRAMS = {{
+    {"poker_action_latency_microseconds", "Time to handle an action message on its table",
+     {10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000}},
+    {"poker_write_batch_messages", "Messages written per connection write cycle",
+     {1, 2, 4, 8, 16, 32, 64, 128, 256, 0, 0}},
+}};
+
+constexpr std::size_t STAGE_COUNT = static_cast<std::size_t>(Stage::COUNT);
+constexpr std::size_t TYPE_COUNT = INVALID_MESSAGE + 1;
+
+constexpr std::array<const char*, STAGE_COUNT> STAGE_NAMES = {
+    "parse", "queue", "handle", "serialize", "write", "end_to_end",
+};
+
+// HDR-style layout: values below LINEAR_LIMIT get a bucket each; above it every
+// power of two is split into SUB_BUCKETS equal buckets
+constexpr int SUB_BUCKET_BITS = 5;
+constexpr std::uint64_t SUB_BUCKETS = std::uint64_t{1} << SUB_BUCKET_BITS;
+constexpr std::uint64_t LINEAR_LIMIT = 2 * SUB_BUCKETS;
+constexpr int VALUE_BITS = 36; // values are clamped below 2^36 ns, about 68s
+constexpr std::size_t LATENCY_BUCKETS = LINEAR_LIMIT + (VALUE_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKETS;
+
+std::size_t latencyBucket(std::uint64_t nanos)
+{
+    nanos = std::min(nanos, (std::uint64_t{1} << VALUE_BITS) - 1);
+    if (nanos < LINEAR_LIMIT)
+    {
+        return static_cast<std::size_t>(nanos);
+    }
+    int top_bit = SUB_BUCKET_BITS + 1;
+    while ((nanos >> (top_bit + 1)) != 0)
+    {
+        ++top_bit;
+    }
+    int shift = top_bit - SUB_BUCKET_BITS;
+    return static_cast<std::size_t>(LINEAR_LIMIT + (top_bit - SUB_BUCKET_BITS - 1) * SUB_BUCKETS +
+                                    ((nanos >> shift) - SUB_BUCKETS));
+}
+
+// Largest value that lands in bucket
+std::uint64_t latencyBucketHigh(std::size_t bucket)
+{
+    if (bucket < LINEAR_LIMIT)
+    {
+        return bucket;
+    }
+    std::size_t octave = (bucket - LINEAR_LIMIT) / SUB_BUCKETS;
+    std::uint64_t sub = (bucket - LINEAR_LIMIT) % SUB_BUCKETS;
+    int shift = static_cast<int>(octave) + 1;
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+struct LatencyCells {
+    std::array<std::atomic<std::uint64_t>, LATENCY_BUCKETS> buckets;
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> sum; // nanoseconds, as are the buckets and max
+    std::atomic<std::uint64_t> max;
+};
+
+// Indexed by stage * TYPE_COUNT + type. About 250KB, so a thread allocates its
+// own the first time it records a latency rather than carrying it inline.
+struct LatencyShard {
+    std::array<LatencyCells, STAGE_COUNT * TYPE_COUNT> cells;
+};
+
+struct HistogramShard {
+    std::array<std::atomic<std::uint64_t>, MAX_BUCKETS> buckets;
+    std::atomic<std::uint64_t> sum;
+    std::atomic<std::uint64_t> count;
+};
+
+// One thread's metrics. Written only by that thread; read by scrapes, hence atomics.
+struct Shard {
+    std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> counters;
+    std::array<HistogramShard, HISTOGRAM_COUNT> histograms;
+    std::atomic<LatencyShard*> latency; // null until the thread records one
+    Shard* next;
+};
+
+// Zero-initialized before anything runs, so operator new can count from the start
+std::mutex g_shards_mutex;
+Shard* g_shards = nullptr;
+Shard g_retired; // totals of exited threads
+LatencyShard g_retired_latency;
+
+void bump(std::atomic<std::uint64_t>& cell, std::uint64_t amount)
+{
+    // Single writer: no read-modify-write needed
+    cell.store(cell.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void add(Shard& into, const Shard& from)
+{
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i)
+    {
+        bump(into.counters[i], from.counters[i].load(std::memory_order_relaxed));
+    }
+    for (std::size_t h = 0; h < HISTOGRAM_COUNT; ++h)
+    {
+        for (std::size_t b = 0; b < MAX_BUCKETS; ++b)
+        {
+            bump(into.histograms[h].buckets[b], from.histograms[h].buckets[b].load(std::memory_order_relaxed));
+        }
+        bump(into.histograms[h].sum, from.histograms[h].sum.load(std::memory_order_relaxed));
+        bump(into.histograms[h].count, from.histograms[h].count.load(std::memory_order_relaxed));
+    }
+}
+
+void addLatency(LatencyCells& into, const LatencyCells& from)
+{
+    for (std::size_t b = 0; b < LATENCY_BUCKETS; ++b)
+    {
+        bump(into.buckets[b], from.buckets[b].load(std::memory_order_relaxed));
+    }
+    bump(into.count, from.count.load(std::memory_order_relaxed));
+    bump(into.sum, from.sum.load(std::memory_order_relaxed));
+    into.max.store(std::max(into.max.load(std::memory_order_relaxed), from.max.load(std::memory_order_relaxed)),
+                   std::memory_order_relaxed);
+}
+
+thread_local Shard* t_shard = nullptr;
+
+// Registers the thread's shard on first use and folds it into g_retired at thread
+// exit. Holds the shard inline, so creating it never allocates.
+struct ShardOwner {
+    Shard shard{};
+
+    ShardOwner()
+    {
+        std::lock_guard<std::mutex> lock(g_shards_mutex);
+        shard.next = g_shards;
+        g_shards = &shard;
+        t_shard = &shard;
+    }
+
+    ~ShardOwner()
+    {
+        LatencyShard* latency = shard.latency.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(g_shards_mutex);
+            for (Shard** link = &g_shards; *link; link = &(*link)->next)
+            {
+                if (*link == &shard)
+                {
+                    *link = shard.next;
+                    break;
+                }
+            }
+            add(g_retired, shard);
+            if (latency)
+            {
+                for (std::size_t i = 0; i < latency->cells.size(); ++i)
+                {
+                    addLatency(g_retired_latency.cells[i], latency->cells[i]);
+                }
+            }
+        }
+        t_shard = nullptr;
+        delete latency;
+    }
+};
+
+thread_local bool t_retired = false;
+
+// nullptr once the thread is past its thread_local destructors
+Shard* localShard()
+{
+    if (t_shard)
+    {
+        return t_shard;
+    }
+    if (t_retired)
+    {
+        return nullptr;
+    }
+    struct Retire {
+        ~Retire() { t_retired = true; }
+    };
+    thread_local ShardOwner owner;
+    thread_local Retire retire;
+    return t_shard;
+}
+
+// Sum of every shard; caller holds g_shards_mutex
+void collect(Shard& total)
+{
+    add(total, g_retired);
+    for (const Shard* shard = g_shards; shard; shard = shard->next)
+    {
+        add(total, *shard);
+    }
+}
+
+// Sum of one stage and type over every shard; caller holds g_shards_mutex
+void collectLatency(std::size_t cell, LatencyCells& total)
+{
+    addLatency(total, g_retired_latency.cells[cell]);
+    for (const Shard* shard = g_shards; shard; shard = shard->next)
+    {
+        if (const LatencyShard* latency = shard->latency.load(std::memory_order_acquire))
+        {
+            addLatency(total, latency->cells[cell]);
+        }
+    }
+}
+
+// Smallest bucket bound covering the given fraction of samples, capped at the exact max
+std::uint64_t latencyAt(const LatencyCells& cells, double quantile)
+{
+    std::uint64_t count = cells.count.load(std::memory_order_relaxed);
+    std::uint64_t max = cells.max.load(std::memory_order_relaxed);
+    auto rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(count))), 1);
+    std::uint64_t cumulative = 0;
+    for (std::size_t b = 0; b < LATENCY_BUCKETS; ++b)
+    {
+        cumulative += cells.buckets[b].load(std::memory_order_relaxed);
+        if (cumulative >= rank)
+        {
+            return std::min(latencyBucketHigh(b), max);
+        }
+    }
+    return max;
+}
+
+LatencySummary summarize(const LatencyCells& cells)
+{
+    LatencySummary summary;
+    summary.count = cells.count.load(std::memory_order_relaxed);
+    if (summary.count == 0)
+    {
+        return summary;
+    }
+    auto nanos = [](std::uint64_t value) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(value));
+    };
+    summary.p50 = nanos(latencyAt(cells, 0.5));
+    summary.p99 = nanos(latencyAt(cells, 0.99));
+    summary.p999 = nanos(latencyAt(cells, 0.999));
+    summary.max = nanos(cells.max.load(std::memory_order_relaxed));
+    return summary;
+}
+
+const char* typeName(std::size_t type)
+{
+    return type == INVALID_MESSAGE ? "invalid" : clientMessageTypeName(static_cast<ClientMessageType>(type));
+}
+
+std::size_t typeOf(const ClientMessage& message)
+{
+    return message.ok() ? static_cast<std::size_t>(message.type) : INVALID_MESSAGE;
+}
+
+// Receive time of the frame being handed to a handler on this thread
+thread_local Clock::time_point t_received;
+// Innermost message being handled on this thread
+thread_local Handling* t_handling = nullptr;
+
+struct Gauge {
+    const void* owner;
+    std::string name;
+    std::string help;
+    std::function<double()> read;
+};
+
+std::mutex& gaugesMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<Gauge>& gauges()
+{
+    static std::vector<Gauge> gauges;
+    return gauges;
+}
+
+void appendNumber(std::string& out, std::uint64_t value)
+{
+    out += std::to_string(value);
+}
+
+void appendMicros(std::string& out, Clock::duration duration)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3f",
+                  static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / 1000.0);
+    out += buffer;
+}
+
+void appendLatencyLabels(std::string& out, std::size_t stage, std::size_t type, const char* quantile)
+{
+    out += "{stage=\"";
+    out += STAGE_NAMES[stage];
+    out += "\",type=\"";
+    out += typeName(type);
+    if (quantile)
+    {
+        out += "\",quantile=\"";
+        out += quantile;
+    }
+    out += "\"} ";
+}
+
+void appendHeader(std::string& out, const char* name, const char* help, const char* type)
+{
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+} // anonymous namespace
+
+void increment(Counter counter, std::uint64_t amount)
+{
+    if (Shard* shard = localShard())
+    {
+        bump(shard->counters[static_cast<std::size_t>(counter)], amount);
+    }
+}
+
+void observe(Histogram histogram, std::uint64_t value)
+{
+    Shard* shard = localShard();
+    if (!shard)
+    {
+        return;
+    }
+    const HistogramInfo& info = HISTOGRAMS[static_cast<std::size_t>(histogram)];
+    HistogramShard& cells = shard->histograms[static_cast<std::size_t>(histogram)];
+    std::size_t bucket = 0;
+    while (bucket < info.bounds.size() && info.bounds[bucket] != 0 && value > info.bounds[bucket])
+    {
+        ++bucket;
+    }
+    // Past the last bound lands in +Inf, the slot after the last used bound
+    bump(cells.buckets[bucket], 1);
+    bump(cells.sum, value);
+    bump(cells.count, 1);
+}
+
+void countReceived(const ClientMessage& message)
+{
+    if (!message.ok())
+    {
+        increment(Counter::MESSAGES_RECEIVED_INVALID);
+        return;
+    }
+    increment(static_cast<Counter>(static_cast<std::size_t>(Counter::MESSAGES_RECEIVED_JOIN) +
+                                   static_cast<std::size_t>(message.type)));
+}
+
+std::uint64_t value(Counter counter)
+{
+    std::lock_guard<std::mutex> lock(g_shards_mutex);
+    std::size_t index = static_cast<std::size_t>(counter);
+    std::uint64_t total = g_retired.counters[index].load(std::memory_order_relaxed);
+    for (const Shard* shard = g_shards; shard; shard = shard->next)
+    {
+        total += shard->counters[index].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void addGauge(const void* owner, std::string name, std::string help, std::function<double()> read)
+{
+    std::lock_guard<std::mutex> lock(gaugesMutex());
+    gauges().push_back(Gauge{owner, std::move(name), std::move(help), std::move(read)});
+}
+
+void removeGauges(const void* owner)
+{
+    std::lock_guard<std::mutex> lock(gaugesMutex());
+    auto& all = gauges();
+    all.erase(std::remove_if(all.begin(), all.end(), [owner](const Gauge& gauge) { return gauge.owner == owner; }),
+              all.end());
+}
+
+void record(Stage stage, std::size_t type, Clock::duration elapsed)
+{
+    Shard* shard = localShard();
+    if (!shard || type >= TYPE_COUNT)
+    {
+        return;
+    }
+    LatencyShard* latency = shard->latency.load(std::memory_order_relaxed);
+    if (!latency)
+    {
+        latency = new LatencyShard();
+        shard->latency.store(latency, std::memory_order_release);
+    }
+    auto nanos = static_cast<std::uint64_t>(
+        std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 0));
+    LatencyCells& cells = latency->cells[static_cast<std::size_t>(stage) * TYPE_COUNT + type];
+    bump(cells.buckets[latencyBucket(nanos)], 1);
+    bump(cells.count, 1);
+    bump(cells.sum, nanos);
+    if (nanos > cells.max.load(std::memory_order_relaxed))
+    {
+        cells.max.store(nanos, std::memory_order_relaxed);
+    }
+}
+
+LatencySummary latency(Stage stage, std::size_t type)
+{
+    if (type >= TYPE_COUNT)
+    {
+        return LatencySummary();
+    }
+    auto total = std::make_unique<LatencyCells>();
+    {
+        std::lock_guard<std::mutex> lock(g_shards_mutex);
+        collectLatency(static_cast<std::size_t>(stage) * TYPE_COUNT + type, *total);
+    }
+    return summarize(*total);
+}
+
+Receiving::Receiving(Clock::time_point received)
+    : previous_(t_received)
+{
+    t_received = received;
+}
+
+Receiving::~Receiving()
+{
+    t_received = previous_;
+}
+
+void traceReceived(ClientMessage& message)
+{
+    if (t_received == Clock::time_point())
+    {
+        return;
+    }
+    auto now = Clock::now();
+    message.received = t_received;
+    message.parsed = now;
+    record(Stage::PARSE, typeOf(message), now - t_received);
+}
+
+Handling::Handling(const ClientMessage& message)
+{
+    if (message.received == Clock::time_point())
+    {
+        return;
+    }
+    trace_ = Trace{typeOf(message), message.received};
+    started_ = Clock::now();
+    record(Stage::QUEUE, trace_.type, started_ - message.parsed);
+    previous_ = t_handling;
+    t_handling = this;
+}
+
+Handling::~Handling()
+{
+    if (!trace_)
+    {
+        return;
+    }
+    t_handling = previous_;
+    auto elapsed = Clock::now() - started_;
+    record(Stage::HANDLE, trace_.type, elapsed - std::min(serializing_, elapsed));
+    record(Stage::SERIALIZE, trace_.type, serializing_);
+}
+
+Serializing::Serializing()
+    : handling_(t_handling)
+{
+    if (handling_)
+    {
+        started_ = Clock::now();
+    }
+}
+
+Serializing::~Serializing()
+{
+    if (handling_)
+    {
+        handling_->addSerializing(Clock::now() - started_);
+    }
+}
+
+Trace currentTrace()
+{
+    return t_handling ? t_handling->trace() : Trace();
+}
+
+std::string render()
+{
+    // Merged into heap copies so the lock is not held while formatting. Allocated
+    // before locking: a counted operator new may need the lock to register a shard.
+    auto total = std::make_unique<Shard>();
+    auto latencies = std::make_unique<LatencyShard>();
+    {
+        std::lock_guard<std::mutex> lock(g_shards_mutex);
+        collect(*total);
+        for (std::size_t cell = 0; cell < latencies->cells.size(); ++cell)
+        {
+            collectLatency(cell, latencies->cells[cell]);
+        }
+    }
+
+    std::string out;
+    out.reserve(4096);
+    for (std::size_t i = 0; i < COUNTER_COUNT; ++i)
+    {
+        const CounterInfo& info = COUNTERS[i];
+        if (info.help)
+        {
+            appendHeader(out, info.name, info.help, "counter");
+        }
+        out += info.name;
+        if (info.labels[0] != '\0')
+        {
+            out += '{';
+            out += info.labels;
+            out += '}';
+        }
+        out += ' ';
+        appendNumber(out, total->counters[i].load(std::memory_order_relaxed));
+        out += '\n';
+    }
+
+    for (std::size_t h = 0; h < HISTOGRAM_COUNT; ++h)
+    {
+        const HistogramInfo& info = HISTOGRAMS[h];
+        const HistogramShard& cells = total->histograms[h];
+        appendHeader(out, info.name, info.help, "histogram");
+        std::uint64_t cumulative = 0;
+        std::size_t bucket = 0;
+        for (; bucket < info.bounds.size() && info.bounds[bucket] != 0; ++bucket)
+        {
+            cumulative += cells.buckets[bucket].load(std::memory_order_relaxed);
+            out += info.name;
+            out += "_bucket{le=\"";
+            appendNumber(out, info.bounds[bucket]);
+            out += "\"} ";
+            appendNumber(out, cumulative);
+            out += '\n';
+        }
+        cumulative += cells.buckets[bucket].load(std::memory_order_relaxed);
+        out += info.name;
+        out += "_bucket{le=\"+Inf\"} ";
+        appendNumber(out, cumulative);
+        out += '\n';
+        out += info.name;
+        out += "_sum ";
+        appendNumber(out, cells.sum.load(std::memory_order_relaxed));
+        out += '\n';
+        out += info.name;
+        out += "_count ";
+        appendNumber(out, cells.count.load(std::memory_order_relaxed));
+        out += '\n';
+    }
+
+    // Series with no samples yet are left out
+    static constexpr const char* LATENCY = "poker_message_latency_microseconds";
+    static constexpr const char* LATENCY_MAX = "poker_message_latency_max_microseconds";
+    static constexpr std::array<std::pair<const char*, double>, 3> QUANTILES = {{
+        {"0.5", 0.5}, {"0.99", 0.99}, {"0.999", 0.999},
+    }};
+    appendHeader(out, LATENCY, "Client message handling latency by pipeline stage and message type", "summary");
+    for (std::size_t stage = 0; stage < STAGE_COUNT; ++stage)
+    {
+        for (std::size_t type = 0; type < TYPE_COUNT; ++type)
+        {
+            const LatencyCells& cells = latencies->cells[stage * TYPE_COUNT + type];
+            std::uint64_t count = cells.count.load(std::memory_order_relaxed);
+            if (count == 0)
+            {
+                continue;
+            }
+            for (const auto& [label, quantile] : QUANTILES)
+            {
+                out += LATENCY;
+                appendLatencyLabels(out, stage, type, label);
+                appendMicros(out, std::chrono::nanoseconds(latencyAt(cells, quantile)));
+                out += '\n';
+            }
+            out += LATENCY;
+            out += "_sum";
+            appendLatencyLabels(out, stage, type, nullptr);
+            appendMicros(out, std::chrono::nanoseconds(cells.sum.load(std::memory_order_relaxed)));
+            out += '\n';
+            out += LATENCY;
+            out += "_count";
+            appendLatencyLabels(out, stage, type, nullptr);
+            appendNumber(out, count);
+            out += '\n';
+        }
+    }
+    appendHeader(out, LATENCY_MAX, "Slowest client message seen, by pipeline stage and message type", "gauge");
+    for (std::size_t stage = 0; stage < STAGE_COUNT; ++stage)
+    {
+        for (std::size_t type = 0; type < TYPE_COUNT; ++type)
+        {
+            const LatencyCells& cells = latencies->cells[stage * TYPE_COUNT + type];
+            if (cells.count.load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+            out += LATENCY_MAX;
+            appendLatencyLabels(out, stage, type, nullptr);
+            appendMicros(out, std::chrono::nanoseconds(cells.max.load(std::memory_order_relaxed)));
+            out += '\n';
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(gaugesMutex());
+    for (const Gauge& gauge : gauges())
+    {
+        appendHeader(out, gauge.name.c_str(), gauge.help.c_str(), "gauge");
+        out += gauge.name;
+        out += ' ';
+        double reading = gauge.read ? gauge.read() : 0.0;
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", reading);
+        out += buffer;
+        out += '\n';
+    }
+    return out;
+}
+
+} // namespace metrics
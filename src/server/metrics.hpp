@@ -0,0 +1,155 @@
+#pragma once
+
+#include "client_message.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Process-wide counters and histograms, exported in the Prometheus text format
+// at /metrics. Updates go to a shard owned by the calling thread: a relaxed
+// load and store with no lock and no shared cache line, so they are cheap
+// enough for the message path and for operator new. A scrape merges every
+// live shard plus the totals left by threads that have exited. Gauges are
+// read through callbacks at scrape time.
+namespace metrics {
+
+enum class Counter : std::size_t {
+    CONNECTIONS_OPENED,
+    CONNECTIONS_CLOSED,
+    MESSAGES_RECEIVED_JOIN,   // in ClientMessageType order
+    MESSAGES_RECEIVED_ACTION,
+    MESSAGES_RECEIVED_PING,
+    MESSAGES_RECEIVED_TOP_UP,
+    MESSAGES_RECEIVED_INVALID,
+    MESSAGES_SENT,
+    BYTES_SENT,
+    HANDS_STARTED,
+    HANDS_COMPLETED,
+    ACTION_TIMEOUTS,
+    ALLOCATIONS,
+    COUNT
+};
+
+enum class Histogram : std::size_t {
+    ACTION_LATENCY_US, // handling one action message on its table's strand
+    WRITE_BATCH_SIZE,  // messages a connection writes in one write cycle
+    COUNT
+};
+
+void increment(Counter counter, std::uint64_t amount = 1);
+void observe(Histogram histogram, std::uint64_t value);
+
+// Count an inbound message under its type, or as invalid if it did not parse
+void countReceived(const ClientMessage& message);
+
+// Sum over all threads, for tests and callers outside the scrape
+std::uint64_t value(Counter counter);
+
+// Gauge read at scrape time. Gauges are grouped by owner so an object can
+// remove the ones that call back into it before it is destroyed.
+void addGauge(const void* owner, std::string name, std::string help, std::function<double()> read);
+void removeGauges(const void* owner);
+
+// Every metric in the Prometheus text exposition format (version 0.0.4)
+std::string render();
+
+// Latency of each stage a client message passes through, by message type, in
+// HDR-style histograms: exact below 64ns, then 32 sub-buckets per power of two
+// (within 3.2%) up to about 68 seconds. Stages are timed with steady_clock and
+// recorded into the calling thread's shard like the counters; the scrape
+// reports p50, p99, p99.9 and the exact max since the process started.
+enum class Stage : std::size_t {
+    PARSE,      // frame read to message parsed
+    QUEUE,      // parsed to its table's strand starting on it
+    HANDLE,     // game logic on the strand, less serialization
+    SERIALIZE,  // building the messages it causes
+    WRITE,      // a message it caused queued to its socket write completing
+    END_TO_END, // frame read to a message it caused being written, per recipient
+    COUNT
+};
+
+// Message type a latency is filed under: a ClientMessageType, or this for
+// messages that failed to parse
+constexpr std::size_t INVALID_MESSAGE = CLIENT_MESSAGE_TYPE_COUNT;
+
+using Clock = std::chrono::steady_clock;
+
+void record(Stage stage, std::size_t type, Clock::duration elapsed);
+
+struct LatencySummary {
+    std::uint64_t count = 0;
+    Clock::duration p50{};
+    Clock::duration p99{};
+    Clock::duration p999{};
+    Clock::duration max{};
+};
+
+// Merged over all threads, for tests and benchmarks
+LatencySummary latency(Stage stage, std::size_t type);
+
+// A client message followed through the pipeline; empty when it is not timed
+struct Trace {
+    std::size_t type = INVALID_MESSAGE;
+    Clock::time_point received;
+
+    explicit operator bool() const { return received != Clock::time_point(); }
+};
+
+// Held by the transport while it hands a frame read at received to its handler
+class Receiving {
+public:
+    explicit Receiving(Clock::time_point received);
+    ~Receiving();
+
+    Receiving(const Receiving&) = delete;
+    Receiving& operator=(const Receiving&) = delete;
+
+private:
+    Clock::time_point previous_;
+};
+
+// Called by a handler once it has parsed a frame: stamps the message with the
+// frame's receive time and records PARSE. A no-op outside a Receiving scope.
+void traceReceived(ClientMessage& message);
+
+// Held around handling a message on its table's strand: records QUEUE on entry,
+// HANDLE and SERIALIZE on exit, and makes the message the current trace so the
+// messages sent meanwhile are attributed to it.
+class Handling {
+public:
+    explicit Handling(const ClientMessage& message);
+    ~Handling();
+
+    Handling(const Handling&) = delete;
+    Handling& operator=(const Handling&) = delete;
+
+    const Trace& trace() const { return trace_; }
+    void addSerializing(Clock::duration elapsed) { serializing_ += elapsed; }
+
+private:
+    Trace trace_;
+    Clock::time_point started_;
+    Clock::duration serializing_{};
+    Handling* previous_ = nullptr;
+};
+
+// Held around building an outbound message; counts toward the current trace's SERIALIZE
+class Serializing {
+public:
+    Serializing();
+    ~Serializing();
+
+    Serializing(const Serializing&) = delete;
+    Serializing& operator=(const Serializing&) = delete;
+
+private:
+    Handling* handling_;
+    Clock::time_point started_;
+};
+
+// The message being handled on this thread, for a transport queueing a message it caused
+Trace currentTrace();
+
+} // namespace metrics
@@ -6,20 +6,17 @@
 
 namespace player_action {
 
-bool validateAction(const Hand& hand, const Player& player, const std::string& action, int amount) {
+bool validateAction(const Hand& hand, const Player& player, Action action, int amount) {
     if (!canAct(hand, player)) {
         return false;
     }
 
-    if (action != "fold" && action != "call" && action != "raise") {
-        return false;
-    }
     if (amount < 0) {
         return false;
     }
 
     // Fold action must have amount of 0
-    if (action == "fold" && amount != 0) {
+    if (action == Action::FOLD && amount != 0) {
         return false;
     }
 
@@ -29,14 +26,14 @@ bool validateAction(const Hand& hand, const Player& player, const std::string& a
     }
 
     // Check player has enough stack for call/raise
-    if (action == "call" || action == "raise") {
+    if (action == Action::CALL || action == Action::RAISE) {
         if (amount > player.stack) {
             return false;
         }
     }
 
     // Raise must be at least min raise
-    if (action == "raise") {
+    if (action == Action::RAISE) {
         if (amount < hand.min_raise) {
             return false;
         }
@@ -49,30 +46,34 @@ bool validateAction(const Hand& hand, const Player& player, const std::string& a
     return true;
 }
 
-bool applyAction(Hand& hand, Player& player, const std::string& action, int amount) {
+bool applyAction(Hand& hand, Player& player, Action action, int amount) {
     if (!validateAction(hand, player, action, amount)) {
         return false;
     }
 
-    if (action == "fold") {
-        for (size_t i = 0; i < hand.players.size(); ++i) {
-            if (hand.players[i] == &player) {
-                if (hand.folded.size() <= i) hand.folded.resize(i + 1, false);
-                hand.folded[i] = true;
-                break;
+    switch (action) {
+        case Action::FOLD:
+            for (size_t i = 0; i < hand.players.size(); ++i) {
+                if (hand.players[i] == &player) {
+                    if (hand.folded.size() <= i) hand.folded.resize(i + 1, false);
+                    hand.folded[i] = true;
+                    break;
+                }
             }
-        }
-    } else if (action == "call") {
-        player.stack -= amount;
-        hand.pot += amount;
-    } else if (action == "raise") {
-        player.stack -= amount;
-        hand.pot += amount;
-        hand.min_raise = amount; // simplistic update
+            break;
+        case Action::CALL:
+            player.stack -= amount;
+            hand.pot += amount;
+            break;
+        case Action::RAISE:
+            player.stack -= amount;
+            hand.pot += amount;
+            hand.min_raise = amount; // simplistic update
+            break;
     }
 
     // Update player's total bet amount
-    if (action != "fold") {
+    if (action != Action::FOLD) {
         // Find player index
         size_t player_index = hand.players.size();
         for (size_t i = 0; i < hand.players.size(); ++i) {
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string>
+#include "../core/betting_rules.hpp"
 
 // Forward declarations
 class Hand;
@@ -9,10 +9,10 @@ class Player;
 namespace player_action {
 
 // Validate a player action (fold, call, raise) given current hand state
-bool validateAction(const Hand& hand, const Player& player, const std::string& action, int amount);
+bool validateAction(const Hand& hand, const Player& player, Action action, int amount);
 
 // Apply a player action to the hand and update player stack, pot, etc.
-bool applyAction(Hand& hand, Player& player, const std::string& action, int amount);
+bool applyAction(Hand& hand, Player& player, Action action, int amount);
 
 // Check if player can act (is active, not folded, has connection)
 bool canAct(const Hand& hand, const Player& player);
@@ -1,31 +1,77 @@
 #include "server.hpp"
-#include "game_session.hpp"
 #include "../common/logging.hpp"
+#include "../common/constants.hpp"
+#include "metrics.hpp"
 #include <boost/asio.hpp>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 using boost::asio::ip::tcp;
 
 Server::Server(boost::asio::io_context& ioc, unsigned short port,
-               int action_timeout_ms, int disconnect_grace_time_ms, int removal_timeout_ms)
-    : acceptor_(ioc, tcp::endpoint(tcp::v4(), port)),
+               int action_timeout_ms, int disconnect_grace_time_ms, int removal_timeout_ms,
+               std::size_t max_tables, std::size_t threads,
+               std::shared_ptr<const PreflopEquityTable> preflop_table, bool replay_log)
+    : ioc_(ioc),
+      acceptor_(ioc, tcp::endpoint(tcp::v4(), port)),
       action_timeout_ms_(action_timeout_ms),
       disconnect_grace_time_ms_(disconnect_grace_time_ms),
       removal_timeout_ms_(removal_timeout_ms),
-      game_session_(std::make_shared<GameSession>(ioc, action_timeout_ms, disconnect_grace_time_ms, removal_timeout_ms))
+      registry_(std::make_shared<TableRegistry>(ioc, max_tables, action_timeout_ms, disconnect_grace_time_ms, removal_timeout_ms,
+                                                       threads, std::move(preflop_table), replay_log))
 {
+    for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i)
+    {
+        heartbeats_.push_back(std::make_shared<HeartbeatSweeper>(
+            ioc, std::chrono::milliseconds(common::constants::PING_INTERVAL_MS),
+            std::chrono::milliseconds(common::constants::PONG_TIMEOUT_MS)));
+    }
+    addGauges();
     start_accept();
 }
 
+Server::~Server()
+{
+    metrics::removeGauges(this);
+}
+
+void Server::addGauges()
+{
+    auto stat = [this](std::size_t TableRegistry::Stats::*field) {
+        return [this, field]() { return static_cast<double>(registry_->stats().*field); };
+    };
+    metrics::addGauge(this, "poker_tables", "Open tables", stat(&TableRegistry::Stats::tables));
+    metrics::addGauge(this, "poker_active_hands", "Tables with a hand in progress", stat(&TableRegistry::Stats::active_hands));
+    metrics::addGauge(this, "poker_seated_players", "Players holding a seat", stat(&TableRegistry::Stats::seated_players));
+    metrics::addGauge(this, "poker_connections", "Connections known to the table registry", stat(&TableRegistry::Stats::connections));
+    metrics::addGauge(this, "poker_table_state_bytes", "Bytes held by tables, seated players and session maps (lower bound)",
+                      stat(&TableRegistry::Stats::state_bytes));
+    metrics::addGauge(this, "poker_armed_timers", "Action and disconnection deadlines armed on the timing wheels",
+                      stat(&TableRegistry::Stats::armed_timers));
+    metrics::addGauge(this, "poker_heartbeat_connections", "Connections kept alive by the heartbeat sweepers", [this]() {
+        std::size_t members = 0;
+        for (const auto& heartbeat : heartbeats_)
+        {
+            members += heartbeat->size();
+        }
+        return static_cast<double>(members);
+    });
+}
+
 void Server::start_accept()
 {
+    // Each connection gets its own strand, so its reads, writes and keep-alive
+    // timers stay serialized when the io_context runs on several threads
     acceptor_.async_accept(
+        boost::asio::make_strand(ioc_),
         [this](boost::system::error_code ec, tcp::socket socket)
         {
             if (!ec)
             {
-                auto session = std::make_shared<WebSocketSession>(std::move(socket));
-                session->setGameSession(game_session_);
+                auto& heartbeat = heartbeats_[next_heartbeat_++ % heartbeats_.size()];
+                auto session = std::make_shared<WebSocketSession>(std::move(socket), heartbeat);
+                session->setHandler(registry_);
                 session->start();
             }
             else
@@ -1,20 +1,38 @@
 #pragma once
 
 #include "websocket_session.hpp"
-#include "game_session.hpp"
+#include "table_registry.hpp"
+#include "heartbeat_sweeper.hpp"
 #include <boost/asio.hpp>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 class Server {
 public:
-    Server(boost::asio::io_context& ioc, unsigned short port, int action_timeout_ms = 30000, int disconnect_grace_time_ms = 30000, int removal_timeout_ms = 60000);
+    Server(boost::asio::io_context& ioc, unsigned short port, int action_timeout_ms = 30000, int disconnect_grace_time_ms = 30000, int removal_timeout_ms = 60000,
+           std::size_t max_tables = 0, std::size_t threads = 1,
+           std::shared_ptr<const PreflopEquityTable> preflop_table = nullptr, bool replay_log = false);
+    ~Server();
+
+    // Port the server listens on, e.g. the one picked for port 0
+    unsigned short port() const { return acceptor_.local_endpoint().port(); }
+
+    const TableRegistry& registry() const { return *registry_; }
 
 private:
     void start_accept();
+    void addGauges();
 
+    boost::asio::io_context& ioc_;
     boost::asio::ip::tcp::acceptor acceptor_;
     int action_timeout_ms_;
     int disconnect_grace_time_ms_;
     int removal_timeout_ms_;
-    std::shared_ptr<GameSession> game_session_;
+    std::shared_ptr<TableRegistry> registry_;
+
+    // One keep-alive sweeper per io thread, handed to connections round-robin
+    // (the accept chain is the only caller, so the counter needs no lock)
+    std::vector<std::shared_ptr<HeartbeatSweeper>> heartbeats_;
+    std::size_t next_heartbeat_ = 0;
 };
@@ -4,11 +4,11 @@
 #include "../core/pot.hpp"
 #include "player_action.hpp"
 #include "../common/constants.hpp"
+#include "../common/logging.hpp"
 #include "../common/uuid.hpp"
 #include <stdexcept>
 #include <algorithm>
 #include <cstdlib>
-#include <memory>
 #include <chrono>
 
 TableManager::TableManager() {
@@ -20,6 +20,17 @@ TableManager::TableManager() {
     table_.community_cards.clear();
     table_.dealer_button_position = common::constants::DEFAULT_DEALER_POSITION;
     table_.state = TableState::WAITING_FOR_PLAYERS;
+#ifndef POKER_SECURE_DECK
+    deck_seed_ = rng::entropySeed();
+#endif
+}
+
+void TableManager::logDeckSeed() const {
+#ifdef POKER_SECURE_DECK
+    common::log::log(common::log::Level::WARN, "Table " + table_.id + " deals from the OS CSPRNG; its hands cannot be replayed");
+#else
+    common::log::log(common::log::Level::INFO, "Table " + table_.id + " deck seed: " + std::to_string(deck_seed_));
+#endif
 }
 
 bool TableManager::assignSeat(std::shared_ptr<Player> player, int seat) {
@@ -76,13 +87,18 @@ bool TableManager::startHand() {
         return false; // hand already in progress
     }
 
-    // Create new hand
-    Hand hand;
-    hand.id = "hand_" + common::uuid::generate();
+    // Reset the inline hand in place; nothing here touches the heap
+    Hand& hand = current_hand_;
+    hand.id = poker::nextHandId();
     hand.table = &table_;
     hand.players = {table_.seat_1, table_.seat_2};
-    hand.deck = Deck(); // Default constructor creates standard deck
-    hand.deck.shuffle(); // Shuffle the deck
+    hand.player_bets.assign({0, 0});
+    hand.folded.assign({false, false});
+#ifdef POKER_SECURE_DECK
+    hand.deck = deck_.fork(); // the OS generator cannot be replayed
+#else
+    hand.deck = Deck::forStream(deck_seed_, hand.id);
+#endif
     hand.community_cards.clear();
     hand.pot = 0;
     hand.side_pots.clear();
@@ -94,10 +110,7 @@ bool TableManager::startHand() {
     hand.history.clear();
     hand.winners.clear();
     hand.completed_at = 0;
-
-    // Store hand in unique_ptr and set table reference
-    this->current_hand_ = std::make_unique<Hand>(hand);
-    table_.current_hand = this->current_hand_.get();
+    table_.current_hand = &hand;
 
     // Deal hole cards
     for (auto player : hand.players) {
@@ -121,11 +134,10 @@ void TableManager::endHand() {
     Hand* hand = table_.current_hand;
 
     // Determine winners
-    std::vector<Player*> winners = poker::determineWinners(*hand);
-    hand->winners = winners;
+    hand->winners = poker::determineWinners(*hand);
 
     // Distribute pot (main pot and side pots)
-    pot::distributePot(*hand, winners);
+    pot::distributePot(*hand, hand->winners);
 
     // Top up players if needed (between hands)
     for (auto& player : players_) {
@@ -141,8 +153,7 @@ void TableManager::endHand() {
     // Set completion timestamp
     hand->completed_at = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
-    // Clear current hand
-    current_hand_.reset();
+    // Clear current hand (the storage is kept for the next one)
     table_.current_hand = nullptr;
     table_.state = TableState::WAITING_FOR_PLAYERS;
     table_.community_cards.clear();
@@ -150,7 +161,7 @@ void TableManager::endHand() {
     table_.dealer_button_position = (table_.dealer_button_position + 1) % (common::constants::SEAT_2 + 1);
 }
 
-bool TableManager::processPlayerAction(const std::string& player_id, const std::string& action, int amount) {
+bool TableManager::processPlayerAction(const std::string& player_id, Action action, int amount) {
     Hand* hand = table_.current_hand;
     if (!hand) return false;
 
@@ -203,7 +214,7 @@ void TableManager::dealCommunityCards() {
     }
 
     for (int i = 0; i < count; ++i) {
-        if (hand->deck.empty()) {
+        if (hand->deck.size() == 0) {
             common::log::log(common::log::Level::ERROR, "Deck exhausted while dealing community cards");
             return;
         }
@@ -3,6 +3,8 @@
 #include "../core/models/table.hpp"
 #include "../core/models/player.hpp"
 #include "../core/models/hand.hpp"
+#include "../core/deck.hpp"
+#include "../core/betting_rules.hpp"
 #include <memory>
 #include <optional>
 #include <vector>
@@ -21,18 +23,29 @@ public:
     TableState getTableState() const { return table_.state; }
     bool isReadyForHand() const { return table_.isReadyForHand(); }
 
+    // Write the deck seed to the log so the table's hands can be replayed. The seed
+    // and a hand id predict that hand's cards, so this is for replay runs only.
+    void logDeckSeed() const;
+
     // Hand management
     bool startHand();
     void endHand();
     const Hand* getCurrentHand() const { return table_.current_hand; }
 
     // Player actions (to be implemented in player_action.cpp)
-    bool processPlayerAction(const std::string& player_id, const std::string& action, int amount);
+    bool processPlayerAction(const std::string& player_id, Action action, int amount);
 
 private:
     Table table_;
     std::vector<std::shared_ptr<Player>> players_;
-    std::unique_ptr<Hand> current_hand_;
+    Hand current_hand_; // reused for every hand; table_.current_hand points here while one is in progress
+#ifdef POKER_SECURE_DECK
+    Deck deck_; // each hand deals from a fork of this deck
+#else
+    // Hand n deals from Deck::forStream(deck_seed_, n). Secret unless logDeckSeed
+    // writes it out, since hand ids are sequential and sent to every client.
+    uint64_t deck_seed_;
+#endif
 
     void dealHoleCards();
     void dealCommunityCards();
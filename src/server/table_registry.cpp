@@ -0,0 +1,259 @@
+#include "table_registry.hpp"
+#include "metrics.hpp"
+#include "../common/logging.hpp"
+#include "../common/uuid.hpp"
+#include "../core/models/player.hpp"
+#include <nlohmann/json.hpp>
+
+namespace {
+
+void sendError(const std::shared_ptr<Transport>& session, const std::string& code, const std::string& message)
+{
+    nlohmann::json error = {
+        {"type", "error"},
+        {"table_id", nullptr},
+        {"payload", {
+            {"code", code},
+            {"message", message}
+        }}
+    };
+    session->send(error.dump());
+}
+
+} // anonymous namespace
+
+TableRegistry::TableRegistry(boost::asio::io_context& ioc, std::size_t max_tables, int action_timeout_ms,
+                             int disconnect_grace_time_ms, int removal_timeout_ms, std::size_t timing_wheels,
+                             std::shared_ptr<const PreflopEquityTable> preflop_table, bool replay_log)
+    : ioc_(ioc),
+      max_tables_(max_tables),
+      action_timeout_ms_(action_timeout_ms),
+      disconnect_grace_time_ms_(disconnect_grace_time_ms),
+      removal_timeout_ms_(removal_timeout_ms),
+      timing_wheels_(ioc, timing_wheels),
+      preflop_table_(std::move(preflop_table)),
+      replay_log_(replay_log)
+{
+}
+
+void TableRegistry::sendWelcome(std::shared_ptr<Transport> session)
+{
+    if (!session) {
+        common::log::log(common::log::Level::ERROR, "TableRegistry::sendWelcome: null session");
+        return;
+    }
+    std::string player_id = common::uuid::generate();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connections_[session] = Connection{player_id, nullptr};
+    }
+    session->send(GameSession::welcomeMessage(player_id, nullptr).dump());
+}
+
+void TableRegistry::handleMessage(std::string_view text, std::shared_ptr<Transport> session)
+{
+    if (!session) {
+        common::log::log(common::log::Level::ERROR, "TableRegistry::handleMessage: null session");
+        return;
+    }
+    // Parsed once here; the table receives the typed message
+    ClientMessage message = parseClientMessage(text);
+    metrics::traceReceived(message);
+    metrics::countReceived(message);
+    std::shared_ptr<GameSession> table;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = connections_.find(session);
+        if (it == connections_.end())
+        {
+            sendError(session, "unauthorized", "Player not registered");
+            return;
+        }
+        // Routing and seating happen under the lock so two joins cannot take the same seat
+        if (!it->second.table)
+        {
+            route(std::move(message), session, it->second);
+            return;
+        }
+        table = it->second.table;
+    }
+    table->handleClientMessage(std::move(message), std::move(session));
+}
+
+bool TableRegistry::route(ClientMessage message, const std::shared_ptr<Transport>& session, Connection& connection)
+{
+    if (!message.ok())
+    {
+        sendError(session, message.error_code, message.error_message);
+        return false;
+    }
+    if (message.type == ClientMessageType::PING)
+    {
+        session->send(nlohmann::json{{"type", "pong"}, {"table_id", nullptr}, {"payload", {}}}.dump());
+        return false;
+    }
+    if (message.type != ClientMessageType::JOIN)
+    {
+        sendError(session, "unauthorized", "Player not registered");
+        return false;
+    }
+
+    // A disconnected player returns to the table that still holds their seat. Naming a
+    // player who is still connected gets no special treatment: that is a new player.
+    if (!message.player_id.empty())
+    {
+        auto it = player_tables_.find(message.player_id);
+        if (it != player_tables_.end() && it->second->awaitsReconnect(it->first))
+        {
+            // The connection keeps its welcome id until the table accepts the reconnect
+            // (see finishReconnect)
+            std::shared_ptr<GameSession> table = it->second;
+            table->registerSession(connection.player_id, session);
+            table->handleReconnectJoin(std::move(message), session);
+            connection.table = table;
+            return true;
+        }
+    }
+
+    std::shared_ptr<GameSession> table = tableWithFreeSeat();
+    if (!table)
+    {
+        sendError(session, "server_full", "No table has a free seat");
+        return false;
+    }
+
+    // The join holds the seat reserved by tableWithFreeSeat until it has run
+    table->registerSession(connection.player_id, session);
+    table->handleReservedJoin(std::move(message), session);
+    connection.table = table;
+    player_tables_[connection.player_id] = table;
+    return true;
+}
+
+void TableRegistry::finishReconnect(const std::shared_ptr<Transport>& session, const std::string& player_id, bool accepted,
+                                    const std::shared_ptr<GameSession>& table)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = connections_.find(session);
+    if (it == connections_.end() || it->second.table != table)
+    {
+        return;
+    }
+    if (accepted)
+    {
+        it->second.player_id = player_id;
+        player_tables_[player_id] = table;
+    }
+    else
+    {
+        // The table has forgotten the session, so its next join is routed afresh
+        it->second.table = nullptr;
+    }
+}
+
+std::shared_ptr<GameSession> TableRegistry::tableWithFreeSeat()
+{
+    for (const auto& table : tables_)
+    {
+        if (table->reserveSeat())
+        {
+            return table;
+        }
+    }
+    if (max_tables_ != 0 && tables_.size() >= max_tables_)
+    {
+        return nullptr;
+    }
+    auto table = std::make_shared<GameSession>(ioc_, timing_wheels_.next(), action_timeout_ms_, disconnect_grace_time_ms_, removal_timeout_ms_);
+    table->setPreflopTable(preflop_table_);
+    if (replay_log_)
+    {
+        table->logDeckSeed();
+    }
+    // Weak both ways: the registry owns its tables, and a table outlives neither
+    table->setPlayerRemovedHandler(
+        [weak_self = weak_from_this(), weak_table = std::weak_ptr<GameSession>(table)](const std::string& player_id) {
+            auto self = weak_self.lock();
+            auto table = weak_table.lock();
+            if (self && table)
+            {
+                self->forgetPlayer(player_id, table);
+            }
+        });
+    table->setReconnectHandler([weak_self = weak_from_this(), weak_table = std::weak_ptr<GameSession>(table)](
+                                   const std::shared_ptr<Transport>& session, const std::string& player_id, bool accepted) {
+        auto self = weak_self.lock();
+        auto table = weak_table.lock();
+        if (self && table)
+        {
+            self->finishReconnect(session, player_id, accepted, table);
+        }
+    });
+    tables_.push_back(table);
+    tables_by_id_[table->tableId()] = table;
+    table->reserveSeat();
+    common::log::log(common::log::Level::INFO, "Opened table " + table->tableId() + " (" + std::to_string(tables_.size()) + " tables)");
+    return table;
+}
+
+void TableRegistry::forgetPlayer(const std::string& player_id, const std::shared_ptr<GameSession>& table)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = player_tables_.find(player_id);
+    if (it != player_tables_.end() && it->second == table)
+    {
+        player_tables_.erase(it);
+    }
+}
+
+void TableRegistry::onDisconnect(std::shared_ptr<Transport> session)
+{
+    if (!session) {
+        common::log::log(common::log::Level::ERROR, "TableRegistry::onDisconnect: null session");
+        return;
+    }
+    Connection connection;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = connections_.find(session);
+        if (it == connections_.end())
+        {
+            return;
+        }
+        connection = std::move(it->second);
+        connections_.erase(it);
+        // Only a seated player can come back to this table
+        if (connection.table && !connection.table->isSeated(connection.player_id))
+        {
+            player_tables_.erase(connection.player_id);
+        }
+    }
+    if (connection.table)
+    {
+        connection.table->onDisconnect(session);
+    }
+}
+
+std::shared_ptr<GameSession> TableRegistry::findTable(const std::string& table_id) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tables_by_id_.find(table_id);
+    return it != tables_by_id_.end() ? it->second : nullptr;
+}
+
+TableRegistry::Stats TableRegistry::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.tables = tables_.size();
+    stats.connections = connections_.size();
+    stats.tracked_players = player_tables_.size();
+    for (const auto& table : tables_)
+    {
+        stats.seated_players += static_cast<std::size_t>(table->seatedPlayers());
+        stats.active_hands += table->hasActiveHand() ? 1 : 0;
+        stats.state_bytes += table->stateBytes();
+    }
+    stats.armed_timers = timing_wheels_.pending();
+    return stats;
+}
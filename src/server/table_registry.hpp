@@ -0,0 +1,79 @@
+#pragma once
+
+#include "game_session.hpp"
+#include "transport.hpp"
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Many heads-up tables in one process. Connections are welcomed here and bound
+// to a table by their first join: a reconnecting player goes back to the table
+// holding their seat, anyone else to the first table with a free seat, and a
+// new table is opened when every table is full. Once bound, a connection's
+// messages go straight to its table's GameSession, so tables share no state and
+// each runs on its own strand. The registry itself is guarded by one mutex that
+// is held only for routing, never while a table does game work.
+class TableRegistry : public ConnectionHandler, public std::enable_shared_from_this<TableRegistry> {
+public:
+    struct Stats {
+        std::size_t tables = 0;
+        std::size_t active_hands = 0;
+        std::size_t seated_players = 0;
+        std::size_t connections = 0;
+        std::size_t tracked_players = 0; // players the registry can route back to a table
+        std::size_t armed_timers = 0; // action and disconnection deadlines on the timing wheels
+        std::size_t state_bytes = 0; // sum of GameSession::stateBytes, a lower bound
+    };
+
+    // max_tables of zero means unlimited. Tables arm their deadlines on timing_wheels
+    // shared wheels, one per io thread, handed out round-robin as tables open.
+    // preflop_table, if any, is shared by every table for the equities in hand_completed.
+    // replay_log logs each new table's deck seed, which makes its deals predictable.
+    TableRegistry(boost::asio::io_context& ioc, std::size_t max_tables = 0, int action_timeout_ms = 30000,
+                  int disconnect_grace_time_ms = 30000, int removal_timeout_ms = 60000, std::size_t timing_wheels = 1,
+                  std::shared_ptr<const PreflopEquityTable> preflop_table = nullptr, bool replay_log = false);
+
+    void sendWelcome(std::shared_ptr<Transport> session) override;
+    void handleMessage(std::string_view message, std::shared_ptr<Transport> session) override;
+    void onDisconnect(std::shared_ptr<Transport> session) override;
+
+    // Table by id, or nullptr
+    std::shared_ptr<GameSession> findTable(const std::string& table_id) const;
+
+    Stats stats() const;
+
+private:
+    struct Connection {
+        std::string player_id;
+        std::shared_ptr<GameSession> table; // null until the first join
+    };
+
+    // Binds an unrouted connection on its join; false (with an error sent) if no seat is available
+    bool route(ClientMessage message, const std::shared_ptr<Transport>& session, Connection& connection);
+    // Table with a seat reserved for the caller, opening one if needed; nullptr at max_tables
+    std::shared_ptr<GameSession> tableWithFreeSeat();
+    // Drops a removed player's way back to table
+    void forgetPlayer(const std::string& player_id, const std::shared_ptr<GameSession>& table);
+    // Binds the connection to the player's id once the table took the reconnect, or unroutes it
+    void finishReconnect(const std::shared_ptr<Transport>& session, const std::string& player_id, bool accepted,
+                         const std::shared_ptr<GameSession>& table);
+
+    boost::asio::io_context& ioc_;
+    std::size_t max_tables_;
+    int action_timeout_ms_;
+    int disconnect_grace_time_ms_;
+    int removal_timeout_ms_;
+    TimingWheelPool timing_wheels_;
+    std::shared_ptr<const PreflopEquityTable> preflop_table_;
+    bool replay_log_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<GameSession>> tables_;
+    std::unordered_map<std::string, std::shared_ptr<GameSession>> tables_by_id_;
+    std::unordered_map<std::string, std::shared_ptr<GameSession>> player_tables_; // last table of each player
+    std::unordered_map<std::shared_ptr<Transport>, Connection> connections_;
+};
@@ -0,0 +1,295 @@
+#include "timing_wheel.hpp"
+#include <algorithm>
+
+TimingWheel::TimingWheel(boost::asio::io_context& ioc, std::chrono::milliseconds tick)
+    : strand_(boost::asio::make_strand(ioc)),
+      tick_timer_(strand_),
+      tick_(std::max<std::chrono::steady_clock::duration>(tick, std::chrono::milliseconds(1))),
+      origin_(std::chrono::steady_clock::now())
+{
+    slots_.fill(NIL);
+}
+
+TimingWheel::~TimingWheel()
+{
+    boost::system::error_code ec;
+    tick_timer_.cancel(ec);
+}
+
+std::uint64_t TimingWheel::ticksAt(std::chrono::steady_clock::time_point time, bool round_up) const
+{
+    if (time <= origin_)
+    {
+        return 0;
+    }
+    auto elapsed = time - origin_;
+    auto ticks = static_cast<std::uint64_t>(elapsed / tick_);
+    if (round_up && elapsed % tick_ != std::chrono::steady_clock::duration::zero())
+    {
+        ++ticks;
+    }
+    return ticks;
+}
+
+TimingWheel::Handle TimingWheel::schedule(std::chrono::milliseconds delay, boost::asio::any_io_executor executor,
+                                          std::function<void()> callback)
+{
+    auto now = std::chrono::steady_clock::now();
+    // Rounded up so a deadline never fires early
+    std::uint64_t deadline = ticksAt(now + std::max(delay, std::chrono::milliseconds::zero()), true);
+
+    bool start = false;
+    Handle handle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (armed_ == 0)
+        {
+            // Nothing to fire while idle, so skip the ticks that passed
+            current_ = std::max(current_, ticksAt(now, false));
+        }
+
+        std::uint32_t index = free_head_;
+        if (index == NIL)
+        {
+            index = static_cast<std::uint32_t>(entries_.size());
+            entries_.emplace_back();
+        }
+        else
+        {
+            free_head_ = entries_[index].next;
+        }
+
+        Entry& entry = entries_[index];
+        // The slot for current_ has already been run
+        entry.deadline = std::max(deadline, current_ + 1);
+        entry.executor = std::move(executor);
+        entry.callback = std::move(callback);
+        link(index);
+        ++armed_;
+
+        handle = Handle{index, entry.generation};
+        if (!ticking_)
+        {
+            ticking_ = true;
+            start = true;
+        }
+    }
+
+    if (start)
+    {
+        startTicking();
+    }
+    return handle;
+}
+
+bool TimingWheel::cancel(Handle handle)
+{
+    if (!handle)
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (handle.index >= entries_.size())
+    {
+        return false;
+    }
+    Entry& entry = entries_[handle.index];
+    if (entry.generation != handle.generation || entry.slot == NIL)
+    {
+        return false;
+    }
+    unlink(handle.index);
+    release(handle.index);
+    --armed_;
+    // The tick timer notices the wheel is empty on its next tick and stops
+    return true;
+}
+
+std::size_t TimingWheel::pending() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return armed_;
+}
+
+void TimingWheel::link(std::uint32_t index)
+{
+    Entry& entry = entries_[index];
+    std::uint64_t delta = entry.deadline > current_ ? entry.deadline - current_ : 0;
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1))))
+    {
+        ++level;
+    }
+    // Past the top level's span: bucket at its far edge and re-bucket when it cascades
+    std::uint64_t bucketed = entry.deadline;
+    std::uint64_t span = std::uint64_t{1} << (SLOT_BITS * LEVELS);
+    if (delta >= span)
+    {
+        bucketed = current_ + span - 1;
+    }
+
+    std::uint32_t slot = static_cast<std::uint32_t>(level * SLOTS + ((bucketed >> (SLOT_BITS * level)) & (SLOTS - 1)));
+    entry.slot = slot;
+    entry.prev = NIL;
+    entry.next = slots_[slot];
+    if (entry.next != NIL)
+    {
+        entries_[entry.next].prev = index;
+    }
+    slots_[slot] = index;
+}
+
+void TimingWheel::unlink(std::uint32_t index)
+{
+    Entry& entry = entries_[index];
+    if (entry.prev != NIL)
+    {
+        entries_[entry.prev].next = entry.next;
+    }
+    else
+    {
+        slots_[entry.slot] = entry.next;
+    }
+    if (entry.next != NIL)
+    {
+        entries_[entry.next].prev = entry.prev;
+    }
+    entry.prev = NIL;
+    entry.next = NIL;
+    entry.slot = NIL;
+}
+
+void TimingWheel::release(std::uint32_t index)
+{
+    Entry& entry = entries_[index];
+    entry.executor = boost::asio::any_io_executor();
+    entry.callback = nullptr;
+    // Generation 0 is reserved for empty handles
+    if (++entry.generation == 0)
+    {
+        entry.generation = 1;
+    }
+    entry.next = free_head_;
+    free_head_ = index;
+}
+
+void TimingWheel::advance(std::uint64_t target, std::vector<Expired>& expired)
+{
+    while (current_ < target && armed_ > 0)
+    {
+        ++current_;
+
+        // A level's slot cascades when every level below it has wrapped
+        for (int level = 1; level < LEVELS; ++level)
+        {
+            if ((current_ & ((std::uint64_t{1} << (SLOT_BITS * level)) - 1)) != 0)
+            {
+                break;
+            }
+            std::uint32_t slot = static_cast<std::uint32_t>(level * SLOTS + ((current_ >> (SLOT_BITS * level)) & (SLOTS - 1)));
+            std::uint32_t index = slots_[slot];
+            slots_[slot] = NIL;
+            while (index != NIL)
+            {
+                std::uint32_t next = entries_[index].next;
+                link(index);
+                index = next;
+            }
+        }
+
+        std::uint32_t slot = static_cast<std::uint32_t>(current_ & (SLOTS - 1));
+        std::uint32_t index = slots_[slot];
+        slots_[slot] = NIL;
+        while (index != NIL)
+        {
+            Entry& entry = entries_[index];
+            std::uint32_t next = entry.next;
+            entry.slot = NIL;
+            expired.push_back(Expired{std::move(entry.executor), std::move(entry.callback)});
+            release(index);
+            --armed_;
+            index = next;
+        }
+    }
+    if (armed_ == 0)
+    {
+        current_ = std::max(current_, target);
+    }
+}
+
+void TimingWheel::startTicking()
+{
+    boost::asio::post(strand_, [weak_self = weak_from_this()]() {
+        if (auto self = weak_self.lock())
+        {
+            self->armTick();
+        }
+    });
+}
+
+void TimingWheel::armTick()
+{
+    std::uint64_t next;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        next = current_ + 1;
+    }
+    tick_timer_.expires_at(origin_ + tick_ * next);
+    tick_timer_.async_wait([weak_self = weak_from_this()](const boost::system::error_code& ec) {
+        if (ec)
+        {
+            return;
+        }
+        if (auto self = weak_self.lock())
+        {
+            self->onTick();
+        }
+    });
+}
+
+void TimingWheel::onTick()
+{
+    std::vector<Expired> expired;
+    bool keep_ticking;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Catch up on every tick that has passed, not just one
+        advance(ticksAt(std::chrono::steady_clock::now(), false), expired);
+        keep_ticking = armed_ > 0;
+        ticking_ = keep_ticking;
+    }
+
+    for (Expired& entry : expired)
+    {
+        boost::asio::post(entry.executor, std::move(entry.callback));
+    }
+    if (keep_ticking)
+    {
+        armTick();
+    }
+}
+
+TimingWheelPool::TimingWheelPool(boost::asio::io_context& ioc, std::size_t wheels, std::chrono::milliseconds tick)
+{
+    wheels_.reserve(std::max<std::size_t>(wheels, 1));
+    for (std::size_t i = 0; i < std::max<std::size_t>(wheels, 1); ++i)
+    {
+        wheels_.push_back(std::make_shared<TimingWheel>(ioc, tick));
+    }
+}
+
+std::size_t TimingWheelPool::pending() const
+{
+    std::size_t pending = 0;
+    for (const auto& wheel : wheels_)
+    {
+        pending += wheel->pending();
+    }
+    return pending;
+}
+
+std::shared_ptr<TimingWheel> TimingWheelPool::next()
+{
+    return wheels_[next_.fetch_add(1, std::memory_order_relaxed) % wheels_.size()];
+}
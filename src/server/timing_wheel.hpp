@@ -0,0 +1,123 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Hierarchical timing wheel (Varghese & Lauck). Deadlines are bucketed by tick
+// into four levels of 64 slots: level 0 holds the next 64 ticks, and each
+// coarser level holds 64 times the span of the one below, cascading its slots
+// down as the wheel turns. Arming and cancelling are O(1) list operations, and
+// one steady_timer per wheel drives every deadline in it, so the kernel sees one
+// timer per wheel however many tables arm deadlines on it. With the default
+// 10ms tick the levels reach about 46 hours; longer delays are re-bucketed until
+// they come within range.
+//
+// Deadlines fire at most one tick late and never early. An expired callback is
+// posted to the executor it was armed with (its table's strand), so the wheel's
+// own strand only ever moves entries. A cancel can race a callback that has
+// already been posted, so callbacks must check the state they time out is still
+// current. schedule() and cancel() are safe from any thread; the tick timer only
+// runs while something is armed.
+class TimingWheel : public std::enable_shared_from_this<TimingWheel> {
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_TICK{10};
+
+    // Names one armed deadline; default constructed handles name nothing
+    struct Handle {
+        std::uint32_t index = 0;
+        std::uint32_t generation = 0;
+
+        explicit operator bool() const { return generation != 0; }
+    };
+
+    explicit TimingWheel(boost::asio::io_context& ioc, std::chrono::milliseconds tick = DEFAULT_TICK);
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // Run callback on executor once delay has passed
+    Handle schedule(std::chrono::milliseconds delay, boost::asio::any_io_executor executor, std::function<void()> callback);
+
+    // Disarm a deadline; false if it already fired, was cancelled, or handle is empty
+    bool cancel(Handle handle);
+
+    // Deadlines armed and not yet fired or cancelled
+    std::size_t pending() const;
+
+private:
+    static constexpr int SLOT_BITS = 6;
+    static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+    static constexpr int LEVELS = 4;
+    static constexpr std::uint32_t NIL = UINT32_MAX;
+
+    struct Entry {
+        std::uint64_t deadline = 0; // in ticks since origin_
+        std::uint32_t prev = NIL;
+        std::uint32_t next = NIL;   // also links the free list
+        std::uint32_t slot = NIL;   // index into slots_ while armed
+        std::uint32_t generation = 1;
+        boost::asio::any_io_executor executor;
+        std::function<void()> callback;
+    };
+
+    struct Expired {
+        boost::asio::any_io_executor executor;
+        std::function<void()> callback;
+    };
+
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    std::uint64_t ticksAt(std::chrono::steady_clock::time_point time, bool round_up) const;
+
+    // Entry list operations; callers hold mutex_
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+    void release(std::uint32_t index);
+    void advance(std::uint64_t target, std::vector<Expired>& expired);
+
+    // Tick timer, run on strand_
+    void startTicking();
+    void armTick();
+    void onTick();
+
+    Strand strand_;
+    boost::asio::steady_timer tick_timer_;
+    const std::chrono::steady_clock::duration tick_;
+    const std::chrono::steady_clock::time_point origin_;
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    std::array<std::uint32_t, SLOTS * LEVELS> slots_;
+    std::uint32_t free_head_ = NIL;
+    std::uint64_t current_ = 0; // last tick processed
+    std::size_t armed_ = 0;
+    bool ticking_ = false;
+};
+
+// One wheel per io thread. Tables take wheels round-robin, so deadlines spread
+// across the tick timers instead of contending on one wheel's lock.
+class TimingWheelPool {
+public:
+    TimingWheelPool(boost::asio::io_context& ioc, std::size_t wheels,
+                    std::chrono::milliseconds tick = TimingWheel::DEFAULT_TICK);
+
+    std::shared_ptr<TimingWheel> next();
+
+    std::size_t size() const { return wheels_.size(); }
+
+    // Deadlines armed across every wheel
+    std::size_t pending() const;
+
+private:
+    std::vector<std::shared_ptr<TimingWheel>> wheels_;
+    std::atomic<std::size_t> next_{0};
+};
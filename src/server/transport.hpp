@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+// One client connection as GameSession sees it. WebSocketSession carries
+// messages over a socket; InMemoryTransport keeps them in the process so
+// protocol-level tests and benchmarks run without sockets or framing.
+class Transport {
+public:
+    // Immutable message text. A broadcast serializes once and every recipient's
+    // queue holds a reference to the same buffer until its write completes.
+    using Payload = std::shared_ptr<const std::string>;
+
+    virtual ~Transport() = default;
+
+    // Queue a text message for the client. May be called from any thread.
+    virtual void send(Payload message) = 0;
+
+    // Single-recipient convenience; takes ownership of the text without copying it
+    void send(std::string message) { send(std::make_shared<const std::string>(std::move(message))); }
+};
+
+// Receives a connection's lifecycle. GameSession serves a single table;
+// TableRegistry routes connections across many tables.
+class ConnectionHandler {
+public:
+    virtual ~ConnectionHandler() = default;
+
+    // Connection accepted
+    virtual void sendWelcome(std::shared_ptr<Transport> session) = 0;
+
+    // Text message from the client. The view points into the transport's receive
+    // buffer and is only valid for the call; handlers parse it before returning.
+    virtual void handleMessage(std::string_view message, std::shared_ptr<Transport> session) = 0;
+
+    // Connection closed or timed out
+    virtual void onDisconnect(std::shared_ptr<Transport> session) = 0;
+};
@@ -1,52 +1,101 @@
 #include "websocket_session.hpp"
-#include "game_session.hpp"
+#include "metrics.hpp"
 #include "../common/logging.hpp"
 #include <iostream>
 
-WebSocketSession::WebSocketSession(tcp::socket socket)
-    : ws_(std::move(socket)), is_writing_(false),
-      ping_timer_(ws_.get_executor()),
-      pong_timeout_timer_(ws_.get_executor()),
-      pong_pending_(false)
+WebSocketSession::WebSocketSession(tcp::socket socket, std::shared_ptr<HeartbeatSweeper> heartbeat)
+    : ws_(std::move(socket)),
+      heartbeat_(std::move(heartbeat))
 {
 }
 
-WebSocketSession::~WebSocketSession()
+void WebSocketSession::setHandler(std::shared_ptr<ConnectionHandler> handler)
 {
-    boost::system::error_code ec;
-    ping_timer_.cancel(ec);
-    pong_timeout_timer_.cancel(ec);
-    if (ec && ec != boost::system::errc::operation_not_permitted && ec != boost::asio::error::operation_aborted) {
-        common::log::log(common::log::Level::WARN, "WebSocketSession destructor: timer cancel error: " + ec.message());
-    }
+    handler_ = handler;
 }
 
-void WebSocketSession::setGameSession(std::shared_ptr<GameSession> game_session)
+void WebSocketSession::start()
 {
-    game_session_ = game_session;
+    // Read the HTTP request first, so the port can serve /metrics next to the upgrade
+    request_.emplace();
+    http::async_read(ws_.next_layer(), buffer_, *request_,
+        beast::bind_front_handler(
+            &WebSocketSession::on_http_read,
+            shared_from_this()));
 }
 
-void WebSocketSession::start()
+void WebSocketSession::on_http_read(beast::error_code ec, std::size_t)
 {
-    ws_.async_accept(
+    if (ec)
+    {
+        if (ec != http::error::end_of_stream)
+        {
+            common::log::log(common::log::Level::ERROR, "HTTP read error: " + ec.message());
+        }
+        return;
+    }
+
+    if (websocket::is_upgrade(*request_))
+    {
+        ws_.async_accept(*request_,
+            beast::bind_front_handler(
+                &WebSocketSession::on_accept,
+                shared_from_this()));
+        return;
+    }
+
+    response_.emplace();
+    response_->version(request_->version());
+    response_->keep_alive(false);
+    if (request_->method() == http::verb::get && request_->target() == "/metrics")
+    {
+        response_->result(http::status::ok);
+        response_->set(http::field::content_type, "text/plain; version=0.0.4; charset=utf-8");
+        response_->body() = metrics::render();
+    }
+    else
+    {
+        response_->result(http::status::not_found);
+        response_->set(http::field::content_type, "text/plain");
+        response_->body() = "Not found\n";
+    }
+    response_->prepare_payload();
+    request_.reset();
+    http::async_write(ws_.next_layer(), *response_,
         beast::bind_front_handler(
-            &WebSocketSession::on_accept,
+            &WebSocketSession::on_http_write,
             shared_from_this()));
 }
 
-void WebSocketSession::send(const std::string& message)
+void WebSocketSession::on_http_write(beast::error_code ec, std::size_t)
 {
-    if (message.empty()) {
+    if (ec)
+    {
+        common::log::log(common::log::Level::ERROR, "HTTP write error: " + ec.message());
+    }
+    // One request per connection
+    beast::error_code shutdown_ec;
+    ws_.next_layer().shutdown(tcp::socket::shutdown_send, shutdown_ec);
+}
+
+void WebSocketSession::send(Payload message)
+{
+    if (!message || message->empty()) {
         common::log::log(common::log::Level::WARN, "WebSocketSession::send: empty message");
         return;
     }
+    metrics::increment(metrics::Counter::MESSAGES_SENT);
+    metrics::increment(metrics::Counter::BYTES_SENT, message->size());
+    // A message caused by a client message is timed until its write completes
+    Outbound outbound{std::move(message), metrics::currentTrace(), {}};
+    if (outbound.trace)
+    {
+        outbound.queued = metrics::Clock::now();
+    }
     net::post(ws_.get_executor(),
-        [self = shared_from_this(), message]()
+        [self = shared_from_this(), outbound = std::move(outbound)]() mutable
         {
-            {
-                std::lock_guard<std::mutex> lock(self->write_queue_mutex_);
-                self->write_queue_.push(message);
-            }
+            self->write_queue_.push_back(std::move(outbound));
             if (!self->is_writing_)
             {
                 self->do_write();
@@ -61,28 +110,30 @@ void WebSocketSession::on_accept(beast::error_code ec)
         common::log::log(common::log::Level::ERROR, "WebSocket accept error: " + ec.message());
         return;
     }
+    request_.reset();
+    metrics::increment(metrics::Counter::CONNECTIONS_OPENED);
     // Send welcome message to client
-    if (auto game_session = game_session_.lock())
+    if (auto handler = handler_.lock())
     {
-        game_session->sendWelcome(shared_from_this());
+        handler->sendWelcome(shared_from_this());
     }
-    // Set control callback to handle pong frames
+    // Set control callback to handle pong frames (called from reads, on the strand).
+    // A weak reference, since the stream that stores the callback is a member.
     ws_.control_callback(
-        [self = shared_from_this()](beast::websocket::frame_type kind, beast::string_view payload)
+        [weak_self = weak_from_this()](beast::websocket::frame_type kind, beast::string_view payload)
         {
-            if (kind == beast::websocket::frame_type::pong)
+            auto self = weak_self.lock();
+            if (self && kind == beast::websocket::frame_type::pong)
             {
-                boost::system::error_code ec;
-                self->pong_timeout_timer_.cancel(ec);
-                if (ec && ec != boost::asio::error::operation_aborted) {
-                    common::log::log(common::log::Level::WARN, "Pong timeout timer cancel error: " + ec.message());
-                }
                 self->pong_pending_ = false;
             }
         });
 
-    // Start periodic ping timer
-    start_ping_timer();
+    // Periodic pings come from the sweeper
+    if (heartbeat_)
+    {
+        heartbeat_->join(shared_from_this());
+    }
 
     do_read();
 }
@@ -104,21 +155,22 @@ void WebSocketSession::on_read(beast::error_code ec, std::size_t bytes_transferr
         {
             common::log::log(common::log::Level::ERROR, "WebSocket read error: " + ec.message());
         }
-        if (auto game_session = game_session_.lock())
-        {
-            game_session->onDisconnect(shared_from_this());
-        }
+        on_closed();
         return;
     }
 
-    if (auto game_session = game_session_.lock())
+    if (auto handler = handler_.lock())
     {
         try {
-            std::string message = beast::buffers_to_string(buffer_.data());
+            // flat_buffer is contiguous, so the handler parses straight from it
+            auto data = buffer_.data();
+            std::string_view message(static_cast<const char*>(data.data()), data.size());
             if (message.empty()) {
                 common::log::log(common::log::Level::WARN, "WebSocketSession::on_read: empty message");
             } else {
-                game_session->handleMessage(message, shared_from_this());
+                // Starts the message's latency trace; the handler stamps it once parsed
+                metrics::Receiving receiving(metrics::Clock::now());
+                handler->handleMessage(message, shared_from_this());
             }
         } catch (const std::exception& e) {
             common::log::log(common::log::Level::ERROR, "WebSocketSession::on_read exception: " + std::string(e.what()));
@@ -131,15 +183,27 @@ void WebSocketSession::on_read(beast::error_code ec, std::size_t bytes_transferr
 
 void WebSocketSession::do_write()
 {
-    is_writing_ = true;
-    ws_.text(true);
-    std::string message;
+    if (write_index_ == write_batch_.size())
     {
-        std::lock_guard<std::mutex> lock(write_queue_mutex_);
-        message = write_queue_.front();
+        // Take everything queued since the last cycle in one go
+        write_batch_.clear();
+        write_index_ = 0;
+        write_batch_.insert(write_batch_.end(),
+                            std::make_move_iterator(write_queue_.begin()),
+                            std::make_move_iterator(write_queue_.end()));
+        write_queue_.clear();
+        if (write_batch_.empty())
+        {
+            is_writing_ = false;
+            return;
+        }
+        metrics::observe(metrics::Histogram::WRITE_BATCH_SIZE, write_batch_.size());
     }
+    is_writing_ = true;
+    ws_.text(true);
+    // The batch holds the payload until on_write, so the buffer outlives the write
     ws_.async_write(
-        net::buffer(message),
+        net::buffer(*write_batch_[write_index_].payload),
         beast::bind_front_handler(
             &WebSocketSession::on_write,
             shared_from_this()));
@@ -150,86 +214,84 @@ void WebSocketSession::on_write(beast::error_code ec, std::size_t bytes_transfer
     if (ec)
     {
         common::log::log(common::log::Level::ERROR, "WebSocket write error: " + ec.message());
+        write_batch_.clear();
+        write_queue_.clear();
+        write_index_ = 0;
         is_writing_ = false;
         return;
     }
 
+    const Outbound& written = write_batch_[write_index_];
+    if (written.trace)
     {
-        std::lock_guard<std::mutex> lock(write_queue_mutex_);
-        write_queue_.pop();
-
-        // If there are more messages, send next one
-        if (!write_queue_.empty())
-        {
-            do_write();
-            return;
-        }
+        auto now = metrics::Clock::now();
+        metrics::record(metrics::Stage::WRITE, written.trace.type, now - written.queued);
+        metrics::record(metrics::Stage::END_TO_END, written.trace.type, now - written.trace.received);
     }
-    is_writing_ = false;
+    ++write_index_;
+    do_write();
 }
 
-void WebSocketSession::start_ping_timer()
+void WebSocketSession::sendHeartbeat()
 {
-    ping_timer_.expires_after(std::chrono::milliseconds(common::constants::PING_INTERVAL_MS));
-    ping_timer_.async_wait(
-        beast::bind_front_handler(
-            &WebSocketSession::on_ping_timer,
-            shared_from_this()));
+    net::post(ws_.get_executor(), beast::bind_front_handler(&WebSocketSession::do_ping, shared_from_this()));
 }
 
-void WebSocketSession::on_ping_timer(beast::error_code ec)
+void WebSocketSession::checkHeartbeat()
 {
-    if (ec)
+    net::post(ws_.get_executor(),
+        [self = shared_from_this()]()
+        {
+            if (self->pong_pending_)
+            {
+                self->on_pong_timeout();
+            }
+        });
+}
+
+void WebSocketSession::do_ping()
+{
+    if (!ws_.is_open())
     {
-        // Timer cancelled
         return;
     }
-
-    // Start pong timeout timer
     pong_pending_ = true;
-    pong_timeout_timer_.expires_after(std::chrono::milliseconds(common::constants::PONG_TIMEOUT_MS));
-    pong_timeout_timer_.async_wait(
-        beast::bind_front_handler(
-            &WebSocketSession::on_pong_timeout,
-            shared_from_this()));
-
-    // Send ping
     ws_.async_ping("",
         beast::bind_front_handler(
-            &WebSocketSession::on_pong,
+            &WebSocketSession::on_ping,
             shared_from_this()));
 }
 
-void WebSocketSession::on_pong_timeout(beast::error_code ec)
+void WebSocketSession::on_pong_timeout()
 {
-    if (ec)
+    // Pong not received in time, treat as disconnect
+    on_closed();
+}
+
+void WebSocketSession::on_closed()
+{
+    // Reads, pings and the pong check can all notice the same loss
+    if (closed_)
     {
-        // Timer cancelled
         return;
     }
-
-    if (pong_pending_)
+    closed_ = true;
+    if (heartbeat_)
     {
-        // Pong not received in time, treat as disconnect
-        if (auto game_session = game_session_.lock())
-        {
-            game_session->onDisconnect(shared_from_this());
-        }
+        heartbeat_->leave(*this);
+    }
+    metrics::increment(metrics::Counter::CONNECTIONS_CLOSED);
+    if (auto handler = handler_.lock())
+    {
+        handler->onDisconnect(shared_from_this());
     }
 }
 
-void WebSocketSession::on_pong(beast::error_code ec)
+void WebSocketSession::on_ping(beast::error_code ec)
 {
     if (ec)
     {
         // Ping failed, treat as disconnect
-        if (auto game_session = game_session_.lock())
-        {
-            game_session->onDisconnect(shared_from_this());
-        }
-        return;
+        on_closed();
     }
-
-    // Schedule next ping
-    start_ping_timer();
 }
@@ -2,54 +2,82 @@
 
 #include <boost/beast.hpp>
 #include <boost/asio.hpp>
-#include <boost/asio/steady_timer.hpp>
 #include <memory>
-#include <queue>
-#include <atomic>
-#include <mutex>
+#include <optional>
+#include <deque>
+#include <vector>
+#include "transport.hpp"
+#include "heartbeat_sweeper.hpp"
+#include "metrics.hpp"
 #include "../common/constants.hpp"
 
 namespace beast = boost::beast;
 namespace websocket = beast::websocket;
+namespace http = beast::http;
 namespace net = boost::asio;
 using tcp = net::ip::tcp;
 
-class GameSession; // forward declaration
-
-class WebSocketSession : public std::enable_shared_from_this<WebSocketSession> {
+// A connection on the server port. It starts as HTTP: a WebSocket upgrade
+// becomes a game connection, GET /metrics is answered with the metrics (see
+// metrics.hpp), and anything else gets a 404.
+//
+// Keep-alive pings come from a shared HeartbeatSweeper rather than timers of
+// the session's own; a pong missing after PONG_TIMEOUT_MS counts as a disconnect.
+class WebSocketSession : public Transport, public HeartbeatSweeper::Peer, public std::enable_shared_from_this<WebSocketSession> {
 public:
-    explicit WebSocketSession(tcp::socket socket);
-    ~WebSocketSession();
+    WebSocketSession(tcp::socket socket, std::shared_ptr<HeartbeatSweeper> heartbeat);
     void start();
 
-    // Send a text message to the client
-    void send(const std::string& message);
+    using Transport::send;
+
+    // Send a text message to the client. The payload is shared, not copied; it
+    // stays referenced until its write completes.
+    void send(Payload message) override;
+
+    // Set the handler (a table or the table registry) for incoming messages
+    void setHandler(std::shared_ptr<ConnectionHandler> handler);
 
-    // Set the game session that will handle incoming messages
-    void setGameSession(std::shared_ptr<GameSession> game_session);
+    // HeartbeatSweeper::Peer
+    void sendHeartbeat() override;
+    void checkHeartbeat() override;
 
 private:
+    void on_http_read(beast::error_code ec, std::size_t bytes_transferred);
+    void on_http_write(beast::error_code ec, std::size_t bytes_transferred);
     void on_accept(beast::error_code ec);
+    void on_closed();
     void do_read();
     void on_read(beast::error_code ec, std::size_t bytes_transferred);
     void do_write();
     void on_write(beast::error_code ec, std::size_t bytes_transferred);
 
-    // Ping/pong keep-alive
-    void start_ping_timer();
-    void on_ping_timer(beast::error_code ec);
-    void on_pong_timeout(beast::error_code ec);
-    void on_pong(beast::error_code ec);
+    // Ping/pong keep-alive, on the strand
+    void do_ping();
+    void on_ping(beast::error_code ec);
+    void on_pong_timeout();
 
     websocket::stream<tcp::socket> ws_;
     beast::flat_buffer buffer_;
-    std::weak_ptr<GameSession> game_session_;
-    std::queue<std::string> write_queue_;
-    std::mutex write_queue_mutex_;
-    std::atomic<bool> is_writing_{false};
-
-    // Ping/pong timers
-    net::steady_timer ping_timer_;
-    net::steady_timer pong_timeout_timer_;
-    std::atomic<bool> pong_pending_{false};
+    std::optional<http::request<http::string_body>> request_; // until the upgrade or response
+    std::optional<http::response<http::string_body>> response_;
+    bool closed_ = false;
+    std::weak_ptr<ConnectionHandler> handler_;
+
+    struct Outbound {
+        Payload payload;
+        metrics::Trace trace;           // the client message that caused it, if timed
+        metrics::Clock::time_point queued;
+    };
+
+    // Outbound messages. Everything below runs on the connection's strand, so
+    // no locking: send() posts there, and a write cycle takes every message
+    // queued so far as one batch and writes it out back to back.
+    std::deque<Outbound> write_queue_;
+    std::vector<Outbound> write_batch_;
+    std::size_t write_index_ = 0;
+    bool is_writing_ = false;
+
+    // Ping/pong state; the sweeper decides when, the strand does the rest
+    std::shared_ptr<HeartbeatSweeper> heartbeat_;
+    bool pong_pending_ = false;
 };
@@ -0,0 +1,80 @@
+#include "self_play.hpp"
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Headless self-play: two in-process strategies play heads-up hands on
+// independent tables, with no server, sockets or JSON in the loop.
+//
+// Usage: poker_sim [--hands N] [--tables N] [--threads N] [--seed N]
+//                  [--strategy-a NAME] [--strategy-b NAME]
+
+namespace {
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--hands N] [--tables N] [--threads N] [--seed N]"
+                 " [--strategy-a NAME] [--strategy-b NAME]\n"
+                 "Strategies: random\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    sim::SelfPlayConfig config;
+    std::size_t threads = 0;
+    std::string names[2] = {"random", "random"};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        try {
+            if (flag == "--hands") {
+                config.hands = std::stoull(value);
+            } else if (flag == "--tables") {
+                config.tables = std::stoull(value);
+            } else if (flag == "--threads") {
+                threads = std::stoul(value);
+            } else if (flag == "--seed") {
+                config.seed = std::stoull(value);
+            } else if (flag == "--strategy-a") {
+                names[0] = value;
+            } else if (flag == "--strategy-b") {
+                names[1] = value;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "invalid value for " << flag << ": " << value << "\n";
+            return 1;
+        }
+    }
+    for (int s = 0; s < 2; ++s) {
+        config.strategies[s] = sim::strategyByName(names[s]);
+        if (!config.strategies[s]) {
+            std::cerr << "unknown strategy: " << names[s] << "\n";
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    ThreadPool pool(threads);
+    sim::SelfPlayResult result = sim::runSelfPlay(config, pool);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "hands:                " << result.hands << "\n"
+              << "seconds:              " << result.seconds << "\n"
+              << "hands/sec:            " << result.handsPerSecond() << "\n"
+              << "showdowns:            " << result.showdowns << "\n"
+              << "net chips (a, b):     " << result.net_chips[0] << ", " << result.net_chips[1] << "\n"
+              << "a bb/100:             " << result.bigBlindsPer100() << "\n"
+              << "rejected actions:     " << result.rejected_actions << "\n"
+              << "invariant violations: " << result.invariant_violations << "\n";
+    return result.invariant_violations == 0 ? 0 : 2;
+}
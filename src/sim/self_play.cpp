@@ -0,0 +1,234 @@
+#include "self_play.hpp"
+#include "../core/card.hpp"
+#include "../core/deck.hpp"
+#include "../core/hand.hpp"
+#include "../core/pot.hpp"
+#include "../core/rng.hpp"
+#include "../common/constants.hpp"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace sim {
+
+namespace {
+
+using common::constants::BIG_BLIND;
+using common::constants::SMALL_BLIND;
+using common::constants::STARTING_STACK;
+
+constexpr int TOTAL_CHIPS = 2 * STARTING_STACK;
+
+struct TableStats {
+    uint64_t hands = 0;
+    uint64_t showdowns = 0;
+    std::array<int64_t, 2> net_chips{};
+    uint64_t rejected_actions = 0;
+    uint64_t invariant_violations = 0;
+};
+
+void postBlind(Hand& hand, std::size_t index, int amount) {
+    Player* player = hand.players[index];
+    amount = std::min(amount, player->stack);
+    player->stack -= amount;
+    hand.player_bets[index] += amount;
+    hand.pot += amount;
+}
+
+bool chipsConserved(const Hand& hand) {
+    int in_play = hand.pot;
+    int bets = 0;
+    for (std::size_t i = 0; i < hand.players.size(); ++i) {
+        if (hand.players[i]->stack < 0) return false;
+        in_play += hand.players[i]->stack;
+        bets += hand.player_bets[i];
+    }
+    return in_play == TOTAL_CHIPS && bets == hand.pot;
+}
+
+// One table's players, strategies and reusable hand state
+class Table {
+public:
+    Table(const SelfPlayConfig& config, uint64_t table_index)
+#ifdef POKER_SECURE_DECK
+        : deck_()
+#else
+        : deck_(Deck::forStream(config.seed, table_index))
+#endif
+    {
+        rng::SplitMix64 seeds(config.seed ^ (table_index * 0xD1B54A32D192ED03ull));
+        for (std::size_t s = 0; s < 2; ++s) {
+            strategies_[s] = config.strategies[s](seeds());
+            players_[s] = Player{"sim" + std::to_string(s), "", STARTING_STACK, static_cast<int>(s), {},
+                                 ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+        }
+    }
+
+    void play(uint64_t hands, TableStats& stats) {
+        for (uint64_t h = 0; h < hands; ++h) {
+            playHand(h % 2, stats);
+        }
+    }
+
+private:
+    // Plays one hand with player `button` on the button (the small blind)
+    void playHand(std::size_t button, TableStats& stats) {
+        for (Player& player : players_) player.stack = STARTING_STACK;
+        Player* small_blind = &players_[button];
+        Player* big_blind = &players_[1 - button];
+        poker::startHand(hand_, deck_, small_blind, small_blind, big_blind);
+        postBlind(hand_, 0, SMALL_BLIND);
+        postBlind(hand_, 1, BIG_BLIND);
+
+        bool violated = !bettingRounds(stats);
+
+        if (!violated) {
+            if (hand_.current_betting_round == BettingRound::SHOWDOWN) {
+                CardSet dealt(hand_.community_cards);
+                for (Player* player : hand_.players) {
+                    CardSet hole(player->hole_cards);
+                    violated |= dealt.intersects(hole);
+                    dealt = dealt | hole;
+                }
+                ++stats.showdowns;
+            }
+            if (!violated) {
+                hand_.winners = poker::determineWinners(hand_);
+                pot::distributePot(hand_, hand_.winners);
+                violated = hand_.pot != 0 || players_[0].stack + players_[1].stack != TOTAL_CHIPS;
+            }
+        }
+
+        ++stats.hands;
+        if (violated) {
+            ++stats.invariant_violations;
+            return;
+        }
+        for (std::size_t s = 0; s < 2; ++s) {
+            stats.net_chips[s] += players_[s].stack - STARTING_STACK;
+        }
+    }
+
+    // Runs betting until a fold or showdown; false on an invariant violation
+    bool bettingRounds(TableStats& stats) {
+        std::array<bool, 2> acted{false, false};
+        while (!poker::isHandComplete(hand_)) {
+            if (hand_.history.full() || !chipsConserved(hand_)) {
+                return false;
+            }
+            std::size_t actor = hand_.current_player_to_act == hand_.players[0] ? 0 : 1;
+            Player& self = *hand_.players[actor];
+            const Player& opponent = *hand_.players[1 - actor];
+
+            int to_call = hand_.player_bets[1 - actor] - hand_.player_bets[actor];
+            DecisionContext context;
+            context.call_amount = std::min(std::max(to_call, 0), self.stack);
+            context.min_raise = std::max(hand_.min_raise, to_call + BIG_BLIND);
+            context.max_raise = self.stack;
+            std::size_t legal = 0;
+            if (to_call > 0) legal_[legal++] = Action::FOLD;
+            legal_[legal++] = Action::CALL;
+            if (context.min_raise <= context.max_raise && opponent.stack > 0) legal_[legal++] = Action::RAISE;
+            context.legal_actions = span<const Action>(legal_.data(), legal);
+
+            Decision decision = strategies_[self.seat]->decide(hand_, self, context);
+            if (!poker::applyAction(hand_, &self, decision.action, decision.amount)) {
+                ++stats.rejected_actions;
+                decision.action = Action::FOLD;
+                poker::applyAction(hand_, &self, Action::FOLD, 0);
+            }
+            if (decision.action == Action::FOLD) {
+                return true;
+            }
+            acted[actor] = true;
+            if (decision.action == Action::RAISE) {
+                acted[1 - actor] = false;
+            }
+
+            if (acted[0] && acted[1] && streetSettled()) {
+                if (!nextStreet()) return false;
+                acted = {false, false};
+            }
+        }
+        return true;
+    }
+
+    // Bets are matched, or the short player is all-in (the uncalled excess is returned)
+    bool streetSettled() {
+        int diff = hand_.player_bets[0] - hand_.player_bets[1];
+        if (diff == 0) return true;
+        std::size_t short_index = diff > 0 ? 1 : 0;
+        if (hand_.players[short_index]->stack != 0) return false;
+        int excess = diff > 0 ? diff : -diff;
+        hand_.player_bets[1 - short_index] -= excess;
+        hand_.players[1 - short_index]->stack += excess;
+        hand_.pot -= excess;
+        return true;
+    }
+
+    // Deals the next street, or runs the board out when someone is all-in
+    bool nextStreet() {
+        bool all_in = hand_.players[0]->stack == 0 || hand_.players[1]->stack == 0;
+        do {
+            if (!poker::advanceBettingRound(hand_)) return false;
+        } while (all_in && hand_.current_betting_round != BettingRound::SHOWDOWN);
+        hand_.current_player_to_act = hand_.players[1]; // big blind acts first after the flop
+        hand_.min_raise = BIG_BLIND;
+        return true;
+    }
+
+    Deck deck_;
+    std::array<Player, 2> players_;
+    std::array<std::unique_ptr<Strategy>, 2> strategies_;
+    std::array<Action, 3> legal_;
+    Hand hand_;
+};
+
+} // anonymous namespace
+
+double SelfPlayResult::bigBlindsPer100() const {
+    if (hands == 0) return 0.0;
+    return static_cast<double>(net_chips[0]) / BIG_BLIND / static_cast<double>(hands) * 100.0;
+}
+
+SelfPlayResult runSelfPlay(const SelfPlayConfig& config, ThreadPool& pool) {
+    for (const StrategyFactory& factory : config.strategies) {
+        if (!factory) {
+            throw std::invalid_argument("runSelfPlay needs a strategy for both players");
+        }
+    }
+    uint64_t tables = config.tables != 0 ? config.tables : 4 * static_cast<uint64_t>(pool.size());
+    tables = std::max<uint64_t>(1, std::min(tables, config.hands));
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<TableStats>> results;
+    results.reserve(tables);
+    for (uint64_t t = 0; t < tables; ++t) {
+        uint64_t hands = config.hands / tables + (t < config.hands % tables ? 1 : 0);
+        results.push_back(pool.submit([&config, t, hands]() {
+            TableStats stats;
+            auto table = std::make_unique<Table>(config, t);
+            table->play(hands, stats);
+            return stats;
+        }));
+    }
+
+    SelfPlayResult result;
+    for (auto& future : results) {
+        TableStats stats = future.get();
+        result.hands += stats.hands;
+        result.showdowns += stats.showdowns;
+        result.rejected_actions += stats.rejected_actions;
+        result.invariant_violations += stats.invariant_violations;
+        for (std::size_t s = 0; s < 2; ++s) {
+            result.net_chips[s] += stats.net_chips[s];
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace sim
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "strategy.hpp"
+#include "../core/thread_pool.hpp"
+#include <array>
+#include <cstdint>
+
+namespace sim {
+
+struct SelfPlayConfig {
+    uint64_t hands = 1000000; // total across all tables
+    uint64_t tables = 0;      // independent tables; zero means four per pool thread
+    uint64_t seed = 1;        // run seed; table t deals Deck::forStream(seed, t)
+    // Strategy for each player. The button alternates every hand, so both
+    // strategies play each position equally often.
+    std::array<StrategyFactory, 2> strategies;
+};
+
+struct SelfPlayResult {
+    uint64_t hands = 0;
+    uint64_t showdowns = 0;                  // hands decided by comparing holdings
+    std::array<int64_t, 2> net_chips{};      // per strategy; sums to zero when chips are conserved
+    uint64_t rejected_actions = 0;           // strategy decisions poker::applyAction refused (played as folds)
+    uint64_t invariant_violations = 0;       // chip conservation, duplicate cards, runaway hands
+    double seconds = 0.0;
+
+    double handsPerSecond() const { return seconds > 0.0 ? hands / seconds : 0.0; }
+    // Big blinds won per 100 hands by strategy 0
+    double bigBlindsPer100() const;
+};
+
+// Plays heads-up hands in-process with the poker:: hand logic, one task per
+// table on the pool. Every hand starts both players from STARTING_STACK and
+// posts the blinds, so results are independent per hand. With the default
+// (non-secure) deck and seeded strategies a run is reproducible for a given
+// seed and table count, whatever the number of threads.
+// Throws std::invalid_argument if a strategy factory is empty.
+SelfPlayResult runSelfPlay(const SelfPlayConfig& config, ThreadPool& pool);
+
+} // namespace sim
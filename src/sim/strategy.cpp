@@ -0,0 +1,18 @@
+#include "strategy.hpp"
+
+namespace sim {
+
+Decision RandomPlayer::decide(const Hand&, const Player&, const DecisionContext& context) {
+    auto [action, amount] = strategy_.chooseAction(context.legal_actions, context.call_amount,
+                                                   context.min_raise, context.max_raise);
+    return {action, amount};
+}
+
+StrategyFactory strategyByName(const std::string& name) {
+    if (name == "random") {
+        return [](uint64_t seed) { return std::make_unique<RandomPlayer>(seed); };
+    }
+    return {};
+}
+
+} // namespace sim
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../core/betting_rules.hpp"
+#include "../core/models/hand.hpp"
+#include "../core/models/player.hpp"
+#include "../core/span.hpp"
+#include "../client/random_strategy.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace sim {
+
+// What a player may do at a decision point. Amounts are chips added to the
+// pot by this action, matching poker::applyAction.
+struct DecisionContext {
+    span<const Action> legal_actions; // non-empty; RAISE only if min_raise <= max_raise
+    int call_amount; // chips needed to match the largest bet (capped at the stack)
+    int min_raise;
+    int max_raise;
+};
+
+struct Decision {
+    Action action;
+    int amount;
+};
+
+// In-process player for self-play. One instance serves one seat of one table,
+// so implementations may keep per-table state and need not be thread-safe.
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+    virtual Decision decide(const Hand& hand, const Player& self, const DecisionContext& context) = 0;
+};
+
+// Builds the strategy for a seat; `seed` is distinct per table and seat
+using StrategyFactory = std::function<std::unique_ptr<Strategy>(uint64_t seed)>;
+
+// Uniformly random legal action, as played by poker_bot
+class RandomPlayer : public Strategy {
+public:
+    explicit RandomPlayer(uint64_t seed) : strategy_(seed) {}
+    Decision decide(const Hand& hand, const Player& self, const DecisionContext& context) override;
+
+private:
+    RandomStrategy strategy_;
+};
+
+// Factory for a strategy name accepted by poker_sim ("random"); empty if unknown
+StrategyFactory strategyByName(const std::string& name);
+
+} // namespace sim
@@ -92,7 +92,7 @@ TEST_F(ChipLeakTest, NoChipLeakAcrossOneHundredHands) {
             
             // Compute possible actions based on hand state
             // For simplicity, we allow fold, call, raise (if possible)
-            std::vector<std::string> possible_actions = {"fold", "call", "raise"};
+            std::vector<Action> possible_actions = {Action::FOLD, Action::CALL, Action::RAISE};
             
             // Remove "raise" if player cannot raise (stack too low)
             int max_bet = maxBet(hand);
@@ -106,20 +106,20 @@ TEST_F(ChipLeakTest, NoChipLeakAcrossOneHundredHands) {
             
             // Randomly choose an action, weighted towards call/raise to keep game moving
             std::uniform_int_distribution<int> action_dist(0, possible_actions.size() - 1);
-            std::string action = possible_actions[action_dist(rng)];
+            Action action = possible_actions[action_dist(rng)];
             
             // Adjust action if not possible
-            if (action == "raise" && !can_raise) {
-                action = (call_amount <= active_player->stack) ? "call" : "fold";
+            if (action == Action::RAISE && !can_raise) {
+                action = (call_amount <= active_player->stack) ? Action::CALL : Action::FOLD;
             }
-            if (action == "call" && call_amount > active_player->stack) {
-                action = "fold";
+            if (action == Action::CALL && call_amount > active_player->stack) {
+                action = Action::FOLD;
             }
             
             int amount = 0;
-            if (action == "call") {
+            if (action == Action::CALL) {
                 amount = call_amount;
-            } else if (action == "raise") {
+            } else if (action == Action::RAISE) {
                 // Random raise between min_raise and player's stack
                 std::uniform_int_distribution<int> raise_dist(hand.min_raise, active_player->stack);
                 amount = raise_dist(rng);
@@ -132,12 +132,12 @@ TEST_F(ChipLeakTest, NoChipLeakAcrossOneHundredHands) {
             bool applied = poker::applyAction(hand, active_player, action, amount);
             if (!applied) {
                 // Action invalid (should not happen with our logic), force fold to continue
-                poker::applyAction(hand, active_player, "fold", 0);
+                poker::applyAction(hand, active_player, Action::FOLD, 0);
             }
             
             // Verify chip conservation after each action
             int after_total = totalChips(hand, players);
-            EXPECT_EQ(before_total, after_total) << "Chip leak detected after action " << action 
+            EXPECT_EQ(before_total, after_total) << "Chip leak detected after action " << actionName(action) 
                                                  << " amount " << amount << " in hand " << hand_num
                                                  << " iteration " << iter;
             
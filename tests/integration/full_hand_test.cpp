@@ -42,7 +42,7 @@ TEST(FullHandFlowTest, FullHandWithFold) {
     poker::startHand(hand, deck, &player1, &player1, &player2);
     
     // Simulate a fold action from player1
-    bool applied = poker::applyAction(hand, &player1, "fold", 0);
+    bool applied = poker::applyAction(hand, &player1, Action::FOLD, 0);
     EXPECT_TRUE(applied);
     
     // After fold, hand should be complete with player2 as winner
@@ -67,11 +67,11 @@ TEST(FullHandFlowTest, FullHandWithAllInSidePot) {
     poker::startHand(hand, deck, &player1, &player1, &player2);
     
     // Player2 raises to 50 (more than player1's stack)
-    bool applied = poker::applyAction(hand, &player2, "raise", 50);
+    bool applied = poker::applyAction(hand, &player2, Action::RAISE, 50);
     EXPECT_TRUE(applied);
     
     // Player1 calls all-in with 100 (total stack)
-    applied = poker::applyAction(hand, &player1, "call", 100);
+    applied = poker::applyAction(hand, &player1, Action::CALL, 100);
     EXPECT_TRUE(applied);
     
     // Calculate side pots
@@ -96,6 +96,41 @@ TEST(FullHandFlowTest, FullHandWithAllInSidePot) {
     EXPECT_TRUE(winners.size() >= 0);
 }
 
+TEST(FullHandFlowTest, ShowdownKickerDecidesWinner) {
+    Player player1{"player1", "Player1", 400, 0, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Player player2{"player2", "Player2", 400, 1, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+
+    Deck deck;
+    Hand hand;
+    poker::startHand(hand, deck, &player1, &player1, &player2);
+
+    // Both players pair their ace; player1's king kicker plays, player2's queen does not
+    player1.hole_cards = {Card("Ah"), Card("Kd")};
+    player2.hole_cards = {Card("Ac"), Card("Qd")};
+    hand.community_cards = {Card("As"), Card("8c"), Card("6d"), Card("4h"), Card("2s")};
+
+    auto winners = poker::determineWinners(hand);
+    ASSERT_EQ(winners.size(), 1);
+    EXPECT_EQ(winners[0], &player1);
+}
+
+TEST(FullHandFlowTest, ShowdownTieSplitsPot) {
+    Player player1{"player1", "Player1", 400, 0, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Player player2{"player2", "Player2", 400, 1, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+
+    Deck deck;
+    Hand hand;
+    poker::startHand(hand, deck, &player1, &player1, &player2);
+
+    // The board plays for both players
+    player1.hole_cards = {Card("2h"), Card("3d")};
+    player2.hole_cards = {Card("2c"), Card("3h")};
+    hand.community_cards = {Card("As"), Card("Ks"), Card("Qd"), Card("Jh"), Card("Tc")};
+
+    auto winners = poker::determineWinners(hand);
+    EXPECT_EQ(winners.size(), 2);
+}
+
 TEST(FullHandFlowTest, PotDistribution) {
     Player player1{"player1", "Player1", 200, 0, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
     Player player2{"player2", "Player2", 200, 1, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
@@ -105,8 +140,8 @@ TEST(FullHandFlowTest, PotDistribution) {
     poker::startHand(hand, deck, &player1, &player1, &player2);
     
     // Both players call a bet of 50
-    poker::applyAction(hand, &player1, "call", 50);
-    poker::applyAction(hand, &player2, "call", 50);
+    poker::applyAction(hand, &player1, Action::CALL, 50);
+    poker::applyAction(hand, &player2, Action::CALL, 50);
     
     // Pot should be 100
     EXPECT_EQ(hand.pot, 100);
@@ -139,12 +174,12 @@ TEST(FullHandFlowTest, PlayerBetsTracking) {
     EXPECT_EQ(hand.player_bets[1], 0);
     
     // Player1 raises 20
-    poker::applyAction(hand, &player1, "raise", 20);
+    poker::applyAction(hand, &player1, Action::RAISE, 20);
     EXPECT_EQ(hand.player_bets[0], 20);
     EXPECT_EQ(hand.player_bets[1], 0);
     
     // Player2 calls 20
-    poker::applyAction(hand, &player2, "call", 20);
+    poker::applyAction(hand, &player2, Action::CALL, 20);
     EXPECT_EQ(hand.player_bets[0], 20);
     EXPECT_EQ(hand.player_bets[1], 20);
 }
\ No newline at end of file
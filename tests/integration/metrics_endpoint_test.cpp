@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <boost/beast/websocket.hpp>
+#include <nlohmann/json.hpp>
+#include "../../src/server/server.hpp"
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace beast = boost::beast;
+namespace asio = boost::asio;
+namespace http = beast::http;
+namespace websocket = beast::websocket;
+
+// The server answers plain HTTP GETs on the WebSocket port
+class MetricsEndpointTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        server = std::make_unique<Server>(server_ioc, 0);
+        port = server->port();
+        server_thread = std::thread([this]() { server_ioc.run(); });
+    }
+
+    void TearDown() override {
+        server_ioc.stop();
+        server_thread.join();
+        server.reset();
+    }
+
+    http::response<http::string_body> get(const std::string& target) {
+        asio::io_context ioc;
+        asio::ip::tcp::socket socket(ioc);
+        socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), port));
+
+        http::request<http::empty_body> request{http::verb::get, target, 11};
+        request.set(http::field::host, "127.0.0.1");
+        http::write(socket, request);
+
+        beast::flat_buffer buffer;
+        http::response<http::string_body> response;
+        http::read(socket, buffer, response);
+        return response;
+    }
+
+    asio::io_context server_ioc;
+    std::unique_ptr<Server> server;
+    std::thread server_thread;
+    unsigned short port = 0;
+};
+
+TEST_F(MetricsEndpointTest, ServesPrometheusText) {
+    auto response = get("/metrics");
+
+    EXPECT_EQ(response.result(), http::status::ok);
+    EXPECT_NE(response[http::field::content_type].find("text/plain"), beast::string_view::npos);
+    EXPECT_NE(response.body().find("# TYPE poker_connections_opened_total counter"), std::string::npos);
+    EXPECT_NE(response.body().find("poker_messages_received_total{type=\"action\"}"), std::string::npos);
+    EXPECT_NE(response.body().find("poker_action_latency_microseconds_bucket{le=\"+Inf\"}"), std::string::npos);
+    EXPECT_NE(response.body().find("# TYPE poker_tables gauge"), std::string::npos);
+}
+
+TEST_F(MetricsEndpointTest, UnknownPathIsNotFound) {
+    EXPECT_EQ(get("/nothing-here").result(), http::status::not_found);
+}
+
+TEST_F(MetricsEndpointTest, WebSocketUpgradeStillGetsWelcome) {
+    asio::io_context ioc;
+    websocket::stream<asio::ip::tcp::socket> ws(ioc);
+    ws.next_layer().connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), port));
+    ws.handshake("127.0.0.1:" + std::to_string(port), "/");
+
+    beast::flat_buffer buffer;
+    ws.read(buffer);
+    auto welcome = nlohmann::json::parse(beast::buffers_to_string(buffer.data()));
+    EXPECT_EQ(welcome["type"], "welcome");
+
+    // The accepted connection now shows in the scrape
+    auto body = get("/metrics").body();
+    EXPECT_EQ(body.find("poker_connections_opened_total 0\n"), std::string::npos);
+
+    // A join is timed from its frame being read to the reply being written
+    ws.write(asio::buffer(std::string(R"({"type":"join","payload":{"name":"alice"}})")));
+    buffer.clear();
+    ws.read(buffer);
+    body = get("/metrics").body();
+    for (const char* stage : {"parse", "queue", "handle", "serialize", "write", "end_to_end"}) {
+        EXPECT_NE(body.find(std::string("poker_message_latency_microseconds_count{stage=\"") + stage + "\",type=\"join\"}"),
+                  std::string::npos) << stage;
+    }
+
+    ws.close(websocket::close_code::normal);
+}
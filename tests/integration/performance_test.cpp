@@ -46,20 +46,20 @@ bool simulateRandomHand(Player& player1, Player& player2, std::mt19937& rng) {
             call_amount = active_player->stack;
         }
         
-        std::string action;
+        Action action;
         int amount = 0;
         if (call_amount == 0) {
-            action = "call"; // check
+            action = Action::CALL; // check
         } else if (call_amount <= active_player->stack) {
-            action = "call";
+            action = Action::CALL;
             amount = call_amount;
         } else {
-            action = "fold";
+            action = Action::FOLD;
         }
         
         bool applied = poker::applyAction(hand, active_player, action, amount);
         if (!applied) {
-            poker::applyAction(hand, active_player, "fold", 0);
+            poker::applyAction(hand, active_player, Action::FOLD, 0);
         }
         ++iter;
     }
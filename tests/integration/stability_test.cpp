@@ -45,8 +45,7 @@ TEST_F(StabilityTest, OneHundredConsecutiveHands) {
         int max_iterations = 1000; // safety limit
         int iter = 0;
         while (!poker::isHandComplete(hand) && iter < max_iterations) {
-            // Determine active player (simplified: assume hand.current_player_index)
-            Player* active_player = hand.players[hand.current_player_index];
+            Player* active_player = hand.current_player_to_act;
             
             // Find active player index and compute betting amounts
             int active_player_index = -1;
@@ -56,7 +55,7 @@ TEST_F(StabilityTest, OneHundredConsecutiveHands) {
                     break;
                 }
             }
-            int player_bet = (active_player_index >= 0 && active_player_index < hand.player_bets.size()) 
+            int player_bet = (active_player_index >= 0 && static_cast<std::size_t>(active_player_index) < hand.player_bets.size()) 
                 ? hand.player_bets[active_player_index] : 0;
             int current_bet = 0;
             for (int bet : hand.player_bets) {
@@ -64,17 +63,17 @@ TEST_F(StabilityTest, OneHundredConsecutiveHands) {
             }
             
             // Generate random valid action
-            std::vector<std::string> possible_actions = {"fold", "call", "raise"};
+            std::vector<Action> possible_actions = {Action::FOLD, Action::CALL, Action::RAISE};
             std::uniform_int_distribution<int> action_dist(0, possible_actions.size() - 1);
-            std::string action = possible_actions[action_dist(rng)];
+            Action action = possible_actions[action_dist(rng)];
             
             int amount = 0;
-            if (action == "call") {
+            if (action == Action::CALL) {
                 amount = current_bet - player_bet;
                 if (amount > active_player->stack) {
                     amount = active_player->stack; // all-in
                 }
-            } else if (action == "raise") {
+            } else if (action == Action::RAISE) {
                 // Random raise between min raise and player's stack
                 int min_raise = BettingRules::calculateMinRaise(current_bet, 4); // big blind = 4
                 if (min_raise <= active_player->stack) {
@@ -83,10 +82,10 @@ TEST_F(StabilityTest, OneHundredConsecutiveHands) {
                 } else {
                     // Cannot raise, fall back to call or fold
                     if (current_bet - player_bet <= active_player->stack) {
-                        action = "call";
+                        action = Action::CALL;
                         amount = current_bet - player_bet;
                     } else {
-                        action = "fold";
+                        action = Action::FOLD;
                         amount = 0;
                     }
                 }
@@ -97,7 +96,7 @@ TEST_F(StabilityTest, OneHundredConsecutiveHands) {
             // Action may be invalid (e.g., raise less than min), in which case we skip iteration
             if (!applied) {
                 // Force fold to avoid infinite loop
-                poker::applyAction(hand, active_player, "fold", 0);
+                poker::applyAction(hand, active_player, Action::FOLD, 0);
             }
             
             ++iter;
@@ -86,4 +86,14 @@ TEST(BettingRulesTest, RaiseExceedingOpponentStack) {
     BettingState round{4, 8, 100};
     EXPECT_TRUE(BettingRules::isValidAction(Action::RAISE, 100, round, 100)); // all-in raise
     EXPECT_FALSE(BettingRules::isValidAction(Action::RAISE, 101, round, 100)); // exceeds stack
-}
\ No newline at end of file
+}
+
+TEST(BettingRulesTest, ActionNamesRoundTrip) {
+    for (Action action : {Action::FOLD, Action::CALL, Action::RAISE}) {
+        EXPECT_EQ(parseAction(actionName(action)), action);
+    }
+    EXPECT_STREQ(actionName(Action::RAISE), "raise");
+    EXPECT_FALSE(parseAction("check").has_value());
+    EXPECT_FALSE(parseAction("Fold").has_value());
+    EXPECT_FALSE(parseAction("").has_value());
+}
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "card.hpp"
 #include "deck.hpp"
+#include <algorithm>
+#include <future>
+#include <vector>
 
 TEST(CardTest, ConstructorFromString) {
     Card card("Ah");
@@ -22,6 +25,37 @@ TEST(CardTest, Equality) {
     EXPECT_NE(c1, c3);
 }
 
+TEST(CardSetTest, ConstexprConstruction) {
+    constexpr CardSet set{Card(Rank::ACE, Suit::SPADES), Card(Rank::KING, Suit::SPADES)};
+    static_assert(set.size() == 2, "two cards");
+    static_assert(set.contains(Card(Rank::ACE, Suit::SPADES)), "contains ace of spades");
+    static_assert(CardSet::fullDeck().size() == NUM_CARDS, "full deck");
+    EXPECT_EQ(set.suitMask(Suit::SPADES), (1u << 12) | (1u << 11));
+    EXPECT_EQ(set.suitMask(Suit::HEARTS), 0u);
+}
+
+TEST(CardSetTest, UnionIntersectionAndDifference) {
+    CardSet hole{Card("Ah"), Card("Kd")};
+    CardSet board{Card("Kd"), Card("7c"), Card("2s")};
+    EXPECT_EQ((hole | board).size(), 4);
+    EXPECT_EQ((hole & board), CardSet{Card("Kd")});
+    EXPECT_TRUE(hole.intersects(board));
+    EXPECT_EQ(board.without(hole), (CardSet{Card("7c"), Card("2s")}));
+    EXPECT_EQ(CardSet::fullDeck().without(hole).size(), 50);
+}
+
+TEST(CardSetTest, RankMaskAndIteration) {
+    std::vector<Card> cards = {Card("2c"), Card("2d"), Card("Th"), Card("As")};
+    CardSet set(cards);
+    EXPECT_EQ(set.rankMask(), (1u << 0) | (1u << 8) | (1u << 12));
+
+    std::vector<Card> iterated(set.begin(), set.end());
+    EXPECT_EQ(iterated.size(), cards.size());
+    for (const Card& card : cards) {
+        EXPECT_NE(std::find(iterated.begin(), iterated.end(), card), iterated.end());
+    }
+}
+
 TEST(DeckTest, Initialization) {
     Deck deck;
     EXPECT_EQ(deck.size(), 52);
@@ -58,4 +92,100 @@ TEST(DeckTest, DealAllCards) {
     }
     EXPECT_EQ(deck.size(), 0);
     EXPECT_THROW(deck.deal(), std::out_of_range);
-}
\ No newline at end of file
+}
+TEST(DeckTest, SeededDecksAreReproducible) {
+    BasicDeck<rng::Xoshiro256StarStar> a(rng::Xoshiro256StarStar(7));
+    BasicDeck<rng::Xoshiro256StarStar> b(rng::Xoshiro256StarStar(7));
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_EQ(a.deal(), b.deal());
+    }
+}
+
+TEST(DeckTest, ShuffleRewindsAndDealsEveryCardOnce) {
+    BasicDeck<rng::Pcg32> deck(rng::Pcg32(3));
+    for (int round = 0; round < 3; ++round) {
+        deck.shuffle();
+        EXPECT_EQ(deck.size(), 52u);
+        CardSet dealt;
+        for (int i = 0; i < 52; ++i) {
+            Card card = deck.deal();
+            EXPECT_FALSE(dealt.contains(card));
+            dealt.add(card);
+        }
+        EXPECT_EQ(dealt, CardSet::fullDeck());
+    }
+}
+
+TEST(DeckTest, PartialDealIsUniform) {
+    // Every card should lead a fresh shuffle about equally often
+    BasicDeck<rng::Xoshiro256StarStar> deck(rng::Xoshiro256StarStar(11));
+    std::vector<int> first(52, 0);
+    constexpr int TRIALS = 52000;
+    for (int i = 0; i < TRIALS; ++i) {
+        deck.shuffle();
+        ++first[deck.deal().toInt()];
+    }
+    double chi_square = 0.0;
+    for (int count : first) {
+        double diff = count - TRIALS / 52.0;
+        chi_square += diff * diff / (TRIALS / 52.0);
+    }
+    EXPECT_LT(chi_square, 100.0); // 51 degrees of freedom; p < 1e-4 above this
+}
+
+TEST(DeckTest, ForkedDecksDealIndependently) {
+    BasicDeck<rng::Xoshiro256StarStar> parent(rng::Xoshiro256StarStar(5));
+    auto first = parent.fork();
+    auto second = parent.fork();
+    bool different = false;
+    for (int i = 0; i < 9 && !different; ++i) {
+        different = first.deal() != second.deal();
+    }
+    EXPECT_TRUE(different);
+    EXPECT_EQ(parent.size(), 52u);
+}
+
+TEST(DeckTest, PhiloxMatchesKnownAnswers) {
+    // Random123 known-answer vectors for philox4x32-10
+    EXPECT_EQ(rng::Philox4x32::bijection({0, 0, 0, 0}, {0, 0}),
+              (rng::Philox4x32::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    EXPECT_EQ(rng::Philox4x32::bijection({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+              (rng::Philox4x32::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+    rng::Philox4x32 generator(42, 9);
+    for (uint64_t block = 0; block < 8; ++block) {
+        for (uint32_t word : generator.generate(block)) EXPECT_EQ(generator(), word);
+    }
+}
+
+std::vector<Card> dealHand(uint64_t seed, uint64_t hand) {
+    auto deck = BasicDeck<rng::Philox4x32>::forStream(seed, hand);
+    std::vector<Card> cards;
+    for (int i = 0; i < 9; ++i) cards.push_back(deck.deal());
+    return cards;
+}
+
+TEST(DeckTest, StreamDecksReplayInAnyOrderOrThread) {
+    constexpr uint64_t SEED = 2024;
+    constexpr uint64_t HANDS = 16;
+    std::vector<std::vector<Card>> forward;
+    for (uint64_t hand = 0; hand < HANDS; ++hand) forward.push_back(dealHand(SEED, hand));
+
+    std::vector<std::future<std::vector<Card>>> parallel;
+    for (uint64_t hand = HANDS; hand-- > 0;) {
+        parallel.push_back(std::async(std::launch::async, dealHand, SEED, hand));
+    }
+    for (uint64_t i = 0; i < HANDS; ++i) {
+        EXPECT_EQ(parallel[i].get(), forward[HANDS - 1 - i]);
+    }
+
+    EXPECT_NE(forward[0], forward[1]);
+    EXPECT_NE(dealHand(SEED, 0), dealHand(SEED + 1, 0));
+}
+
+TEST(DeckTest, SystemRandomDeckDeals) {
+    BasicDeck<rng::SystemRandom> deck;
+    CardSet dealt;
+    for (int i = 0; i < 9; ++i) dealt.add(deck.deal());
+    EXPECT_EQ(dealt.size(), 9);
+}
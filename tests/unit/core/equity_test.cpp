@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "equity.hpp"
+#include "hand_evaluator.hpp"
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+CardSet cards(std::initializer_list<const char*> names) {
+    CardSet set;
+    for (const char* name : names) {
+        set.add(Card(name));
+    }
+    return set;
+}
+
+// Exact equity of player 0 by enumerating every runout of the missing board cards
+double enumerateEquity(const std::vector<CardSet>& holes, CardSet board) {
+    CardSet used = board;
+    for (CardSet hole : holes) used |= hole;
+    std::vector<Card> deck(CardSet::fullDeck().without(used).begin(), CardSet::fullDeck().end());
+    double share = 0.0;
+    int runouts = 0;
+    for (std::size_t a = 0; a < deck.size(); ++a) {
+        for (std::size_t b = a + 1; b < deck.size(); ++b) {
+            CardSet full = board | CardSet{deck[a], deck[b]};
+            HandStrength s0 = HandEvaluator::evaluate(holes[0] | full);
+            HandStrength s1 = HandEvaluator::evaluate(holes[1] | full);
+            share += s0 > s1 ? 1.0 : (s0 == s1 ? 0.5 : 0.0);
+            ++runouts;
+        }
+    }
+    return share / runouts;
+}
+
+} // anonymous namespace
+
+TEST(EquityTest, FlopEstimateMatchesEnumeration) {
+    ThreadPool pool(2);
+    equity::EquityRequest request;
+    request.hole_cards = {cards({"Ah", "Kh"}), cards({"Qs", "Qd"})};
+    request.board = cards({"2h", "7h", "9c"});
+    request.seed = 7;
+    request.target_std_error = 0.003;
+
+    equity::EquityResult result = equity::monteCarlo(request, pool);
+    double exact = enumerateEquity(request.hole_cards, request.board);
+
+    ASSERT_EQ(result.players.size(), 2u);
+    EXPECT_TRUE(result.converged);
+    EXPECT_LE(result.players[0].std_error, 0.003);
+    EXPECT_NEAR(result.players[0].equity, exact, 4 * result.players[0].std_error);
+    EXPECT_NEAR(result.players[0].equity + result.players[1].equity, 1.0, 1e-9);
+    EXPECT_LE(result.players[0].ci_low, result.players[0].equity);
+    EXPECT_GE(result.players[0].ci_high, result.players[0].equity);
+}
+
+TEST(EquityTest, SameSeedIsReproducibleAcrossPoolSizes) {
+    equity::EquityRequest request;
+    request.hole_cards = {cards({"As", "Ac"}), cards({"8d", "9d"}), cards({"Kh", "Qh"})};
+    request.seed = 42;
+    request.max_trials = 50000;
+    request.target_std_error = 0.0;
+
+    ThreadPool one(1);
+    ThreadPool four(4);
+    equity::EquityResult a = equity::monteCarlo(request, one);
+    equity::EquityResult b = equity::monteCarlo(request, four);
+
+    EXPECT_EQ(a.trials, 50000u);
+    EXPECT_FALSE(a.converged);
+    ASSERT_EQ(a.trials, b.trials);
+    for (std::size_t p = 0; p < a.players.size(); ++p) {
+        EXPECT_DOUBLE_EQ(a.players[p].equity, b.players[p].equity);
+        EXPECT_DOUBLE_EQ(a.players[p].tie, b.players[p].tie);
+    }
+}
+
+TEST(EquityTest, DeadCardsAreNeverDealt) {
+    ThreadPool pool(2);
+    equity::EquityRequest request;
+    // Aces full against kings full; the case king is the only out
+    request.hole_cards = {cards({"Ah", "Ad"}), cards({"Ac", "Kc"})};
+    request.board = cards({"As", "Ks", "Kd", "2h"});
+    request.seed = 1;
+
+    equity::EquityResult live = equity::monteCarlo(request, pool);
+    EXPECT_GT(live.players[1].win, 0.0);
+
+    request.dead = cards({"Kh"});
+    equity::EquityResult dead = equity::monteCarlo(request, pool);
+    EXPECT_TRUE(dead.converged);
+    EXPECT_DOUBLE_EQ(dead.players[0].win, 1.0);
+    EXPECT_DOUBLE_EQ(dead.players[1].loss, 1.0);
+}
+
+TEST(EquityTest, CompleteBoardIsExact) {
+    ThreadPool pool(1);
+    equity::EquityRequest request;
+    request.hole_cards = {cards({"Ah", "Kd"}), cards({"Ad", "Kh"})};
+    request.board = cards({"2c", "7s", "9d", "Jc", "3h"});
+
+    equity::EquityResult result = equity::monteCarlo(request, pool);
+    EXPECT_EQ(result.trials, 1u);
+    EXPECT_TRUE(result.converged);
+    EXPECT_DOUBLE_EQ(result.players[0].tie, 1.0);
+    EXPECT_DOUBLE_EQ(result.players[0].equity, 0.5);
+}
+
+TEST(EquityTest, EnumerationMatchesBruteForce) {
+    ThreadPool pool(2);
+    equity::EquityRequest request;
+    request.hole_cards = {cards({"Ah", "Kh"}), cards({"Qs", "Qd"})};
+    request.board = cards({"2h", "7h", "9c"});
+    equity::EquityResult result = equity::enumerate(request, pool);
+    EXPECT_EQ(result.trials, 990u);
+    EXPECT_NEAR(result.players[0].equity, enumerateEquity(request.hole_cards, request.board), 1e-12);
+
+    // Spades/hearts and clubs/diamonds are interchangeable here, so runouts are scored by orbit
+    request.hole_cards = {cards({"As", "Ah"}), cards({"Kc", "Kd"})};
+    request.board = cards({"Qs", "Qh", "4c", "4d"});
+    result = equity::enumerate(request, pool);
+    EXPECT_EQ(result.trials, 44u);
+    EXPECT_NEAR(result.players[0].equity, 1.0 - 2.0 / 44, 1e-12); // kings need one of two kings
+    EXPECT_NEAR(result.players[1].win, 2.0 / 44, 1e-12);
+}
+
+TEST(EquityTest, EnumerationIsIdenticalAcrossPoolSizes) {
+    equity::EquityRequest request;
+    request.hole_cards = {cards({"As", "Ks"}), cards({"Jh", "Jd"}), cards({"7c", "6c"})};
+    request.board = cards({"Ts", "9c", "2h"});
+
+    ThreadPool one(1);
+    ThreadPool three(3);
+    equity::EquityResult a = equity::enumerate(request, one);
+    equity::EquityResult b = equity::enumerate(request, three);
+    EXPECT_EQ(a.trials, 903u);
+    for (std::size_t p = 0; p < a.players.size(); ++p) {
+        EXPECT_EQ(a.players[p].equity, b.players[p].equity);
+        EXPECT_EQ(a.players[p].win, b.players[p].win);
+        EXPECT_EQ(a.players[p].tie, b.players[p].tie);
+    }
+    EXPECT_NEAR(a.players[0].equity + a.players[1].equity + a.players[2].equity, 1.0, 1e-12);
+}
+
+TEST(EquityTest, PreflopEnumerationCoversEveryBoard) {
+    ThreadPool pool(2);
+    equity::EquityRequest request;
+    request.hole_cards = {cards({"As", "Ah"}), cards({"Kc", "Kd"})};
+    equity::EquityResult result = equity::enumerate(request, pool);
+    EXPECT_EQ(result.trials, 1712304u);
+    EXPECT_NEAR(result.players[0].equity + result.players[1].equity, 1.0, 1e-12);
+    EXPECT_GT(result.players[0].equity, 0.8);
+    EXPECT_LT(result.players[0].equity, 0.85);
+}
+
+TEST(EquityTest, RejectsInvalidRequests) {
+    ThreadPool pool(1);
+    equity::EquityRequest request;
+    request.hole_cards = {cards({"Ah", "Kd"})};
+    EXPECT_THROW(equity::monteCarlo(request, pool), std::invalid_argument);
+
+    request.hole_cards = {cards({"Ah", "Kd"}), cards({"Ah", "Qs"})};
+    EXPECT_THROW(equity::monteCarlo(request, pool), std::invalid_argument);
+
+    request.hole_cards = {cards({"Ah", "Kd"}), cards({"Qs"})};
+    EXPECT_THROW(equity::monteCarlo(request, pool), std::invalid_argument);
+
+    request.hole_cards = {cards({"Ah", "Kd"}), cards({"Qs", "Qd"})};
+    request.dead = cards({"Kd"});
+    EXPECT_THROW(equity::monteCarlo(request, pool), std::invalid_argument);
+}
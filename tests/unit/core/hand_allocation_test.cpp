@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "hand.hpp"
+#include "deck.hpp"
+#include "pot.hpp"
+#include "models/player.hpp"
+#include "server/table_manager.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+// Every global allocation in this binary goes through these counters
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// Plays a hand to showdown with a raise, a call and the full board
+void playHand(Hand& hand, Deck& deck, Player& player1, Player& player2) {
+    poker::startHand(hand, deck, &player1, &player1, &player2);
+    poker::applyAction(hand, &player1, Action::RAISE, 20);
+    poker::applyAction(hand, &player2, Action::CALL, 20);
+    while (poker::advanceBettingRound(hand)) {
+    }
+    poker::calculateSidePots(hand);
+    hand.winners = poker::determineWinners(hand);
+    pot::distributePot(hand, hand.winners);
+}
+
+// Plays a table hand through a call and a raise to a fold, as the server drives one
+void playTableHand(TableManager& table) {
+    ASSERT_TRUE(table.startHand());
+    for (auto [action, amount] : {std::pair{Action::CALL, 0}, std::pair{Action::RAISE, 20}, std::pair{Action::FOLD, 0}}) {
+        ASSERT_TRUE(table.processPlayerAction(table.getCurrentHand()->current_player_to_act->id, action, amount));
+    }
+    ASSERT_TRUE(poker::isHandComplete(*table.getCurrentHand()));
+    table.endHand();
+}
+
+} // namespace
+
+TEST(HandAllocationTest, PlayingAHandDoesNotAllocate) {
+    Player player1{"player1", "Player1", 400, 0, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Player player2{"player2", "Player2", 400, 1, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Deck deck;
+    Hand hand;
+    playHand(hand, deck, player1, player2); // warm up thread-local seeding
+
+    size_t before = g_allocations.load();
+    for (int i = 0; i < 100; ++i) {
+        playHand(hand, deck, player1, player2);
+        poker::resetHand(hand);
+    }
+    EXPECT_EQ(g_allocations.load(), before);
+}
+
+// TableManager deals each hand into storage it keeps, never a per-hand heap copy
+TEST(HandAllocationTest, TableHandDoesNotAllocate) {
+    TableManager table;
+    ASSERT_TRUE(table.assignSeat(std::make_shared<Player>(Player{"player1", "Player1", 400, 0, {}, ConnectionStatus::CONNECTED, 0,
+                                                                 std::nullopt, false}),
+                                 common::constants::SEAT_1));
+    ASSERT_TRUE(table.assignSeat(std::make_shared<Player>(Player{"player2", "Player2", 400, 1, {}, ConnectionStatus::CONNECTED, 0,
+                                                                 std::nullopt, false}),
+                                 common::constants::SEAT_2));
+    playTableHand(table); // warm up thread-local seeding
+
+    size_t before = g_allocations.load();
+    for (int i = 0; i < 100; ++i) {
+        playTableHand(table);
+    }
+    EXPECT_EQ(g_allocations.load(), before);
+}
+
+TEST(HandAllocationTest, HandIdsAreNumericAndUnique) {
+    Player player1{"player1", "Player1", 400, 0, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Player player2{"player2", "Player2", 400, 1, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Deck deck;
+    Hand hand;
+    poker::startHand(hand, deck, &player1, &player1, &player2);
+    uint64_t first = hand.id;
+    poker::startHand(hand, deck, &player1, &player1, &player2);
+    EXPECT_NE(first, 0u);
+    EXPECT_GT(hand.id, first);
+    // On the wire the id follows a per-process prefix
+    EXPECT_EQ(poker::formatHandId(7).substr(18), "-0000-000000000007");
+    EXPECT_EQ(poker::formatHandId(7).substr(0, 18), poker::formatHandId(first).substr(0, 18));
+}
+
+TEST(HandAllocationTest, FullHistoryRejectsFurtherActions) {
+    Player player1{"player1", "Player1", 100000, 0, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Player player2{"player2", "Player2", 100000, 1, {}, ConnectionStatus::CONNECTED, 0, std::nullopt, false};
+    Deck deck;
+    Hand hand;
+    poker::startHand(hand, deck, &player1, &player1, &player2);
+    while (!hand.history.full()) {
+        ASSERT_TRUE(poker::applyAction(hand, hand.current_player_to_act, Action::CALL, 0));
+    }
+    int stack = hand.current_player_to_act->stack;
+    EXPECT_FALSE(poker::applyAction(hand, hand.current_player_to_act, Action::CALL, 10));
+    EXPECT_EQ(hand.current_player_to_act->stack, stack);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "hand_evaluator.hpp"
+#include "card.hpp"
+#include "hand_ranking.hpp"
+#include <algorithm>
+#include <array>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+Card cardFromIndex(int index) {
+    return Card(static_cast<Rank>(index / 4), static_cast<Suit>(index % 4));
+}
+
+HandStrength evaluate(const std::vector<Card>& cards) {
+    return HandEvaluator::evaluate(cards.data(), cards.size());
+}
+
+std::vector<Card> parse(std::initializer_list<const char*> cards) {
+    std::vector<Card> result;
+    for (const char* c : cards) {
+        result.emplace_back(c);
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+TEST(HandEvaluatorTest, AllFiveCardHandsHaveExpectedDistribution) {
+    std::map<HandRank, int> frequencies;
+    std::set<uint16_t> distinct;
+    std::array<Card, 5> hand;
+    for (int a = 0; a < 52; ++a)
+    for (int b = a + 1; b < 52; ++b)
+    for (int c = b + 1; c < 52; ++c)
+    for (int d = c + 1; d < 52; ++d)
+    for (int e = d + 1; e < 52; ++e) {
+        hand = {cardFromIndex(a), cardFromIndex(b), cardFromIndex(c), cardFromIndex(d), cardFromIndex(e)};
+        HandStrength strength = HandEvaluator::evaluate(hand.data(), hand.size());
+        ++frequencies[strength.rank()];
+        distinct.insert(strength.value());
+    }
+
+    EXPECT_EQ(distinct.size(), static_cast<std::size_t>(HandEvaluator::NUM_DISTINCT_HANDS));
+    EXPECT_EQ(frequencies[HandRank::HIGH_CARD], 1302540);
+    EXPECT_EQ(frequencies[HandRank::ONE_PAIR], 1098240);
+    EXPECT_EQ(frequencies[HandRank::TWO_PAIR], 123552);
+    EXPECT_EQ(frequencies[HandRank::THREE_OF_A_KIND], 54912);
+    EXPECT_EQ(frequencies[HandRank::STRAIGHT], 10200);
+    EXPECT_EQ(frequencies[HandRank::FLUSH], 5108);
+    EXPECT_EQ(frequencies[HandRank::FULL_HOUSE], 3744);
+    EXPECT_EQ(frequencies[HandRank::FOUR_OF_A_KIND], 624);
+    EXPECT_EQ(frequencies[HandRank::STRAIGHT_FLUSH], 36);
+    EXPECT_EQ(frequencies[HandRank::ROYAL_FLUSH], 4);
+}
+
+TEST(HandEvaluatorTest, SevenCardsMatchBestFiveCardSubset) {
+    std::mt19937 rng(12345);
+    std::vector<int> deck(52);
+    for (int trial = 0; trial < 20000; ++trial) {
+        for (int i = 0; i < 52; ++i) deck[i] = i;
+        std::shuffle(deck.begin(), deck.end(), rng);
+        std::size_t count = 5 + trial % 3;
+        std::vector<Card> cards;
+        for (std::size_t i = 0; i < count; ++i) cards.push_back(cardFromIndex(deck[i]));
+
+        HandStrength best;
+        std::vector<bool> pick(count, false);
+        std::fill(pick.begin(), pick.begin() + 5, true);
+        do {
+            std::vector<Card> subset;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (pick[i]) subset.push_back(cards[i]);
+            }
+            best = std::max(best, evaluate(subset));
+        } while (std::prev_permutation(pick.begin(), pick.end()));
+
+        ASSERT_EQ(evaluate(cards), best);
+    }
+}
+
+TEST(HandEvaluatorTest, KickersBreakTies) {
+    EXPECT_GT(evaluate(parse({"Ah", "Ad", "Ks", "7c", "3h"})), evaluate(parse({"As", "Ac", "Qs", "Jc", "Th"})));
+    EXPECT_GT(evaluate(parse({"Kh", "Kd", "4s", "4c", "3h"})), evaluate(parse({"Ks", "Kc", "4h", "4d", "2h"})));
+    EXPECT_EQ(evaluate(parse({"Ah", "Kd", "Qs", "Jc", "9h"})), evaluate(parse({"Ad", "Kh", "Qc", "Js", "9d"})));
+}
+
+TEST(HandEvaluatorTest, WheelIsLowestStraight) {
+    HandStrength wheel = evaluate(parse({"Ah", "2d", "3s", "4c", "5h"}));
+    HandStrength six_high = evaluate(parse({"6h", "2d", "3s", "4c", "5h"}));
+    EXPECT_EQ(wheel.rank(), HandRank::STRAIGHT);
+    EXPECT_LT(wheel, six_high);
+}
+
+TEST(HandEvaluatorTest, BoardPairDoesNotBeatFlush) {
+    std::vector<Card> cards = parse({"2h", "7h", "9h", "Jh", "Kh", "Ks", "Kd"});
+    EXPECT_EQ(evaluate(cards).rank(), HandRank::FLUSH);
+}
+
+TEST(HandEvaluatorTest, RejectsInvalidInput) {
+    std::vector<Card> four = parse({"Ah", "Kd", "Qs", "Jc"});
+    EXPECT_THROW(evaluate(four), std::invalid_argument);
+    std::vector<Card> duplicate = parse({"Ah", "Ah", "Qs", "Jc", "9d"});
+    EXPECT_THROW(evaluate(duplicate), std::invalid_argument);
+}
+
+TEST(HandEvaluatorTest, BatchMatchesScalar) {
+    std::mt19937 rng(2024);
+    std::vector<int> deck(52);
+    std::vector<CardSet> hands;
+    for (int trial = 0; trial < 10003; ++trial) {
+        for (int i = 0; i < 52; ++i) deck[i] = i;
+        std::shuffle(deck.begin(), deck.end(), rng);
+        CardSet hand;
+        for (int i = 0; i < 5 + trial % 3; ++i) hand.add(cardFromIndex(deck[i]));
+        hands.push_back(hand);
+    }
+    // Make sure flushes land in the vector lanes too
+    hands[3] = CardSet{Card("2h"), Card("7h"), Card("9h"), Card("Jh"), Card("Kh"), Card("Ks"), Card("Kd")};
+
+    std::vector<HandStrength> results(hands.size());
+    HandRanking::evaluateBatch(hands, results);
+    for (std::size_t i = 0; i < hands.size(); ++i) {
+        ASSERT_EQ(results[i], HandEvaluator::evaluate(hands[i])) << "hand " << i;
+    }
+    EXPECT_EQ(results[3].rank(), HandRank::FLUSH);
+}
+
+TEST(HandEvaluatorTest, BatchRejectsInvalidInput) {
+    std::vector<CardSet> hands(9, CardSet{Card("Ah"), Card("Kd"), Card("Qs"), Card("Jc"), Card("9h")});
+    std::vector<HandStrength> results(8);
+    EXPECT_THROW(HandRanking::evaluateBatch(hands, results), std::invalid_argument);
+
+    results.resize(9);
+    hands[4] = CardSet{Card("Ah"), Card("Kd")};
+    EXPECT_THROW(HandRanking::evaluateBatch(hands, results), std::invalid_argument);
+}
+
+TEST(HandEvaluatorTest, IncrementalStateMatchesFullEvaluation) {
+    std::mt19937 rng(555);
+    std::vector<int> deck(52);
+    for (int trial = 0; trial < 5000; ++trial) {
+        for (int i = 0; i < 52; ++i) deck[i] = i;
+        std::shuffle(deck.begin(), deck.end(), rng);
+
+        EvaluatorState hole;
+        hole.add(cardFromIndex(deck[0])).add(cardFromIndex(deck[1]));
+        EvaluatorState flop = hole.with(EvaluatorState(CardSet{cardFromIndex(deck[2]), cardFromIndex(deck[3]),
+                                                               cardFromIndex(deck[4])}));
+        EvaluatorState turn = flop.with(cardFromIndex(deck[5]));
+        EvaluatorState river = turn.with(cardFromIndex(deck[6]));
+
+        ASSERT_EQ(flop.size(), 5);
+        ASSERT_EQ(flop.strength(), HandEvaluator::evaluate(flop.cards()));
+        ASSERT_EQ(turn.strength(), HandEvaluator::evaluate(turn.cards()));
+        ASSERT_EQ(river.strength(), HandEvaluator::evaluate(river.cards()));
+        ASSERT_EQ(river.rankCounts(), EvaluatorState(river.cards()).rankCounts());
+    }
+}
+
+TEST(HandEvaluatorTest, IncrementalStateRejectsDuplicatesAndShortHands) {
+    EvaluatorState state(CardSet{Card("Ah"), Card("Kd")});
+    EXPECT_THROW(state.add(Card("Ah")), std::invalid_argument);
+    EXPECT_THROW(state.add(CardSet{Card("Kd"), Card("2c")}), std::invalid_argument);
+    EXPECT_THROW(state.strength(), std::invalid_argument);
+    EXPECT_EQ(state.size(), 2);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "hand_indexer.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Deal hole and board cards from a shuffled deck
+std::pair<CardSet, CardSet> randomHand(int board_cards, std::mt19937& rng) {
+    std::vector<int> deck(NUM_CARDS);
+    for (int i = 0; i < NUM_CARDS; ++i) deck[i] = i;
+    std::shuffle(deck.begin(), deck.end(), rng);
+    CardSet hole;
+    CardSet board;
+    for (int i = 0; i < HandIndexer::HOLE_CARDS; ++i) {
+        hole.add(Card(static_cast<Rank>(deck[i] / NUM_SUITS), static_cast<Suit>(deck[i] % NUM_SUITS)));
+    }
+    for (int i = 0; i < board_cards; ++i) {
+        int card = deck[HandIndexer::HOLE_CARDS + i];
+        board.add(Card(static_cast<Rank>(card / NUM_SUITS), static_cast<Suit>(card % NUM_SUITS)));
+    }
+    return {hole, board};
+}
+
+} // anonymous namespace
+
+TEST(HandIndexerTest, RangesAreMinimal) {
+    EXPECT_EQ(HandIndexer(0).size(), 169u);
+    EXPECT_EQ(HandIndexer(3).size(), 1286792u);
+    EXPECT_EQ(HandIndexer(4).size(), 13960050u);
+    EXPECT_EQ(HandIndexer(5).size(), 123156254u);
+}
+
+TEST(HandIndexerTest, PreflopCoversEveryIndex) {
+    HandIndexer indexer(0);
+    std::set<uint64_t> seen;
+    for (Card a : CardSet::fullDeck()) {
+        for (Card b : CardSet::fullDeck()) {
+            if (a.toInt() < b.toInt()) seen.insert(indexer.index(CardSet{a, b}, CardSet()));
+        }
+    }
+    EXPECT_EQ(seen.size(), 169u);
+    EXPECT_EQ(*seen.rbegin(), 168u);
+
+    EXPECT_EQ(indexer.index(CardSet{Card("As"), Card("Ks")}, CardSet()),
+              indexer.index(CardSet{Card("Ac"), Card("Kc")}, CardSet()));
+    EXPECT_NE(indexer.index(CardSet{Card("As"), Card("Ks")}, CardSet()),
+              indexer.index(CardSet{Card("As"), Card("Kc")}, CardSet()));
+}
+
+TEST(HandIndexerTest, SuitPermutationsShareAnIndex) {
+    std::mt19937 rng(99);
+    std::array<int, NUM_SUITS> perm = {0, 1, 2, 3};
+    for (int board_cards : {3, 4, 5}) {
+        HandIndexer indexer(board_cards);
+        for (int trial = 0; trial < 2000; ++trial) {
+            auto [hole, board] = randomHand(board_cards, rng);
+            std::shuffle(perm.begin(), perm.end(), rng);
+            uint64_t index = indexer.index(hole, board);
+            ASSERT_LT(index, indexer.size());
+            ASSERT_EQ(indexer.index(hole.permuteSuits(perm), board.permuteSuits(perm)), index);
+        }
+    }
+}
+
+TEST(HandIndexerTest, UnindexRoundTrips) {
+    HandIndexer flop(3);
+    for (uint64_t index = 0; index < flop.size(); index += 97) {
+        auto [hole, board] = flop.unindex(index);
+        ASSERT_EQ(hole.size(), 2);
+        ASSERT_EQ(board.size(), 3);
+        ASSERT_EQ(flop.index(hole, board), index);
+    }
+
+    std::mt19937 rng(7);
+    HandIndexer river(5);
+    for (int trial = 0; trial < 2000; ++trial) {
+        auto [hole, board] = randomHand(5, rng);
+        uint64_t index = river.index(hole, board);
+        auto [canonical_hole, canonical_board] = river.unindex(index);
+        ASSERT_EQ(river.index(canonical_hole, canonical_board), index);
+        ASSERT_EQ(canonical_hole.rankMask(), hole.rankMask());
+        ASSERT_EQ(canonical_board.rankMask(), board.rankMask());
+    }
+    EXPECT_EQ(river.unindex(river.size() - 1).second.size(), 5);
+}
+
+TEST(HandIndexerTest, RejectsInvalidInput) {
+    EXPECT_THROW(HandIndexer(2), std::invalid_argument);
+    HandIndexer flop(3);
+    CardSet hole{Card("Ah"), Card("Kh")};
+    EXPECT_THROW(flop.index(hole, CardSet{Card("2c"), Card("3c")}), std::invalid_argument);
+    EXPECT_THROW(flop.index(hole, CardSet{Card("Ah"), Card("2c"), Card("3c")}), std::invalid_argument);
+    EXPECT_THROW(flop.unindex(flop.size()), std::out_of_range);
+}
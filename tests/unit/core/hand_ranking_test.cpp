@@ -83,4 +83,35 @@ TEST(HandRankingTest, CompareSameRank) {
     };
     // hand1 should be better (higher high card)
     EXPECT_GT(HandRanking::compare(hand1, hand2), 0);
-}
\ No newline at end of file
+}
+
+TEST(HandRankingTest, CompareSameRankKickers) {
+    std::vector<Card> hand1 = {
+        Card("Ah"), Card("Ad"), Card("Ks"), Card("7c"), Card("3h"), Card("2d"), Card("4s")
+    };
+    std::vector<Card> hand2 = {
+        Card("As"), Card("Ac"), Card("Qs"), Card("Jc"), Card("Th"), Card("2d"), Card("4s")
+    };
+    EXPECT_GT(HandRanking::compare(hand1, hand2), 0);
+    EXPECT_LT(HandRanking::compare(hand2, hand1), 0);
+}
+
+TEST(HandRankingTest, CompareTie) {
+    std::vector<Card> hand1 = {
+        Card("2h"), Card("3d"), Card("Ks"), Card("Kc"), Card("Qh"), Card("Jd"), Card("9s")
+    };
+    std::vector<Card> hand2 = {
+        Card("2c"), Card("4h"), Card("Ks"), Card("Kc"), Card("Qh"), Card("Jd"), Card("9s")
+    };
+    EXPECT_EQ(HandRanking::compare(hand1, hand2), 0);
+    EXPECT_EQ(HandRanking::strength(hand1), HandRanking::strength(hand2));
+}
+
+TEST(HandRankingTest, StrengthEncodesCategory) {
+    std::vector<Card> hand = {
+        Card("Kh"), Card("Kd"), Card("Ks"), Card("Jc"), Card("Jh")
+    };
+    HandStrength strength = HandRanking::strength(hand);
+    EXPECT_EQ(strength.rank(), HandRank::FULL_HOUSE);
+    EXPECT_EQ(strength.rank(), HandRanking::evaluate(hand));
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "preflop_table.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+CardSet hand(const char* a, const char* b) {
+    return CardSet{Card(a), Card(b)};
+}
+
+class PreflopTableFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // ctest runs each test in its own process, possibly in parallel, so every test gets its own file
+        path_ = ::testing::TempDir() + "preflop_table_test_" +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name() + "_" +
+                std::to_string(::getpid()) + ".bin";
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    // Synthetic tables whose entries encode their own indices
+    void writeSyntheticTable() {
+        constexpr int CLASSES = PreflopEquityTable::NUM_CLASSES;
+        constexpr int COMBOS = PreflopEquityTable::NUM_COMBOS;
+        std::vector<float> classes(static_cast<std::size_t>(CLASSES) * CLASSES);
+        for (std::size_t i = 0; i < classes.size(); ++i) {
+            classes[i] = static_cast<float>(i) / classes.size();
+        }
+        std::vector<float> combos(static_cast<std::size_t>(COMBOS) * COMBOS);
+        for (std::size_t i = 0; i < combos.size(); ++i) {
+            combos[i] = static_cast<float>(i % 1000) / 1000.0f;
+        }
+        PreflopEquityTable::write(path_, classes, combos);
+    }
+
+    std::string path_;
+};
+
+} // anonymous namespace
+
+TEST(PreflopTableTest, ClassIndicesCoverAllStartingHands) {
+    std::set<int> classes;
+    for (int combo = 0; combo < PreflopEquityTable::NUM_COMBOS; ++combo) {
+        CardSet cards = PreflopEquityTable::comboAt(combo);
+        EXPECT_EQ(PreflopEquityTable::comboIndex(cards), combo);
+        classes.insert(PreflopEquityTable::classIndex(cards));
+    }
+    EXPECT_EQ(classes.size(), static_cast<std::size_t>(PreflopEquityTable::NUM_CLASSES));
+
+    EXPECT_EQ(PreflopEquityTable::className(PreflopEquityTable::classIndex(hand("As", "Ah"))), "AA");
+    EXPECT_EQ(PreflopEquityTable::className(PreflopEquityTable::classIndex(hand("Kd", "Ad"))), "AKs");
+    EXPECT_EQ(PreflopEquityTable::className(PreflopEquityTable::classIndex(hand("7c", "2h"))), "72o");
+    EXPECT_THROW(PreflopEquityTable::classIndex(CardSet{Card("As")}), std::invalid_argument);
+}
+
+TEST_F(PreflopTableFileTest, LookupsReadTheMappedFile) {
+    writeSyntheticTable();
+    PreflopEquityTable table(path_);
+
+    int aa = PreflopEquityTable::classIndex(hand("As", "Ah"));
+    int aks = PreflopEquityTable::classIndex(hand("As", "Ks"));
+    std::size_t cell = static_cast<std::size_t>(aa) * PreflopEquityTable::NUM_CLASSES + aks;
+    EXPECT_FLOAT_EQ(table.classEquity(aa, aks),
+                    static_cast<float>(cell) / (PreflopEquityTable::NUM_CLASSES * PreflopEquityTable::NUM_CLASSES));
+
+    CardSet hero = hand("Ac", "Kd");
+    CardSet villain = hand("7h", "7s");
+    std::size_t entry = static_cast<std::size_t>(PreflopEquityTable::comboIndex(hero)) * PreflopEquityTable::NUM_COMBOS +
+                        PreflopEquityTable::comboIndex(villain);
+    EXPECT_FLOAT_EQ(table.equity(hero, villain), static_cast<float>(entry % 1000) / 1000.0f);
+    EXPECT_THROW(table.equity(hero, hand("Ac", "2c")), std::invalid_argument);
+
+    PreflopEquityTable moved(std::move(table));
+    EXPECT_FLOAT_EQ(moved.equity(hero, villain), static_cast<float>(entry % 1000) / 1000.0f);
+}
+
+TEST_F(PreflopTableFileTest, RejectsMissingOrCorruptFiles) {
+    EXPECT_THROW(PreflopEquityTable(path_ + ".missing"), std::runtime_error);
+
+    writeSyntheticTable();
+    {
+        std::fstream file(path_, std::ios::in | std::ios::out | std::ios::binary);
+        file.write("XXXX", 4);
+    }
+    EXPECT_THROW(PreflopEquityTable{path_}, std::runtime_error);
+
+    {
+        std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+        file << "short";
+    }
+    EXPECT_THROW(PreflopEquityTable{path_}, std::runtime_error);
+}
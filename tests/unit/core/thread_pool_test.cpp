@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "thread_pool.hpp"
+#include <atomic>
+#include <vector>
+
+TEST(ThreadPoolTest, RunsEverySubmittedTask) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.size(), 3u);
+
+    std::atomic<int> counter{0};
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 200; ++i) {
+        results.push_back(pool.submit([&counter, i]() {
+            counter.fetch_add(1);
+            return i * 2;
+        }));
+    }
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(results[i].get(), i * 2);
+    }
+    EXPECT_EQ(counter.load(), 200);
+}
+
+TEST(ThreadPoolTest, TasksCanQueueMoreWork) {
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+    std::vector<std::future<void>> inner(10);
+    auto outer = pool.submit([&]() {
+        for (auto& f : inner) {
+            f = pool.submit([&counter]() { counter.fetch_add(1); });
+        }
+    });
+    outer.get();
+    for (auto& f : inner) {
+        f.get();
+    }
+    EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(ThreadPoolTest, PropagatesExceptions) {
+    ThreadPool pool(1);
+    auto result = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, DestructorDrainsQueuedWork) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; ++i) {
+            pool.submit([&counter]() { counter.fetch_add(1); });
+        }
+    }
+    EXPECT_EQ(counter.load(), 50);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../../src/server/client_message.hpp"
+#include "../../src/core/hand.hpp"
+#include <limits>
+#include <string>
+
+TEST(ClientMessageTest, ParsesAction) {
+    ClientMessage message = parseClientMessage(
+        R"({"type":"action","payload":{"hand_id":")" + poker::formatHandId(42) + R"(","action":"raise","amount":120}})");
+    ASSERT_TRUE(message.ok());
+    EXPECT_EQ(message.type, ClientMessageType::ACTION);
+    EXPECT_TRUE(message.has_hand_id);
+    ASSERT_TRUE(message.hand_id);
+    EXPECT_EQ(*message.hand_id, 42u);
+    ASSERT_TRUE(message.action);
+    EXPECT_EQ(*message.action, Action::RAISE);
+    EXPECT_TRUE(message.has_amount);
+    EXPECT_EQ(message.amount, 120);
+}
+
+TEST(ClientMessageTest, ParsesJoinInAnyKeyOrder) {
+    ClientMessage message = parseClientMessage(
+        R"({"payload":{"player_id":"abc","extra":{"name":"nested"},"name":"alice"},"type":"join"})");
+    ASSERT_TRUE(message.ok());
+    EXPECT_EQ(message.type, ClientMessageType::JOIN);
+    ASSERT_TRUE(message.name);
+    EXPECT_EQ(*message.name, "alice");
+    EXPECT_EQ(message.player_id, "abc");
+}
+
+TEST(ClientMessageTest, SkipsUnknownFields) {
+    ClientMessage message = parseClientMessage(
+        R"({"type":"ping","table_id":null,"meta":[1,{"a":[true]}],"payload":{"note":"x"}})");
+    ASSERT_TRUE(message.ok());
+    EXPECT_EQ(message.type, ClientMessageType::PING);
+}
+
+TEST(ClientMessageTest, MissingFieldsKeepTheirErrors) {
+    ClientMessage message = parseClientMessage(R"({"payload":{}})");
+    EXPECT_STREQ(message.error_code, "invalid_json");
+    EXPECT_STREQ(message.error_message, "Missing 'type' field");
+
+    message = parseClientMessage(R"({"type":"ping"})");
+    EXPECT_STREQ(message.error_message, "Missing 'payload' field");
+
+    message = parseClientMessage(R"({"type":"shout","payload":{}})");
+    EXPECT_STREQ(message.error_code, "invalid_message_type");
+
+    // Field checks are left to the handler, which knows which fields its type needs
+    message = parseClientMessage(R"({"type":"action","payload":{"action":"fold"}})");
+    ASSERT_TRUE(message.ok());
+    EXPECT_FALSE(message.has_hand_id);
+    EXPECT_FALSE(message.has_amount);
+}
+
+TEST(ClientMessageTest, RejectsMalformedInput) {
+    for (const char* text : {
+             "{not json",
+             "",
+             "[]",
+             R"("join")",
+             R"({"type":7,"payload":{}})",
+             R"({"type":"join","payload":[]})",
+             R"({"type":"join","payload":{"name":5}})",
+             R"({"type":"action","payload":{"amount":"10"}})",
+             R"({"type":"action","payload":{"hand_id":{}}})",
+             R"({"type":"ping","payload":{}} trailing)",
+             R"({"type":"ping","payload":{"a":[[[[[[[[[[]]]]]]]]]]}})",
+         }) {
+        ClientMessage message = parseClientMessage(text);
+        EXPECT_STREQ(message.error_code, "invalid_json") << text;
+        EXPECT_STREQ(message.error_message, "Failed to parse JSON") << text;
+    }
+}
+
+TEST(ClientMessageTest, AmountClampsToIntRange) {
+    EXPECT_EQ(parseClientMessage(R"({"type":"action","payload":{"amount":0}})").amount, 0);
+    EXPECT_EQ(parseClientMessage(R"({"type":"action","payload":{"amount":-5}})").amount, -5);
+    EXPECT_EQ(parseClientMessage(R"({"type":"action","payload":{"amount":12.9}})").amount, 12);
+    EXPECT_EQ(parseClientMessage(R"({"type":"action","payload":{"amount":99999999999}})").amount,
+              std::numeric_limits<int>::max());
+    EXPECT_EQ(parseClientMessage(R"({"type":"action","payload":{"amount":-99999999999}})").amount,
+              std::numeric_limits<int>::min());
+}
+
+TEST(ClientMessageTest, UnknownActionAndHandIdAreKeptAsAbsent) {
+    ClientMessage message = parseClientMessage(
+        R"({"type":"action","payload":{"hand_id":"h1","action":"check","amount":0}})");
+    ASSERT_TRUE(message.ok());
+    EXPECT_TRUE(message.has_hand_id);
+    EXPECT_FALSE(message.hand_id);
+    EXPECT_TRUE(message.has_action);
+    EXPECT_FALSE(message.action);
+}
+
+TEST(ClientMessageTest, HandIdRoundTrip) {
+    EXPECT_EQ(poker::parseHandId(poker::formatHandId(1)), 1u);
+    EXPECT_EQ(poker::parseHandId(poker::formatHandId(18446744073709551615ull)), 18446744073709551615ull);
+
+    // uuid-shaped, with the id in the last 16 hex digits
+    std::string text = poker::formatHandId(0x2a);
+    ASSERT_EQ(text.size(), 36u);
+    EXPECT_EQ(text.substr(18), "-0000-00000000002a");
+    EXPECT_EQ(text[8], '-');
+    EXPECT_EQ(text[13], '-');
+
+    EXPECT_FALSE(poker::parseHandId(poker::formatHandId(0)));
+    EXPECT_FALSE(poker::parseHandId("hand_1"));
+    EXPECT_FALSE(poker::parseHandId(text.substr(0, 35)));
+    std::string upper = text;
+    upper[35] = 'A';
+    EXPECT_FALSE(poker::parseHandId(upper));
+    std::string no_dash = text;
+    no_dash[8] = '0';
+    EXPECT_FALSE(poker::parseHandId(no_dash));
+
+    // Another process's ids carry another prefix
+    std::string foreign = text;
+    foreign[0] = foreign[0] == '0' ? '1' : '0';
+    EXPECT_FALSE(poker::parseHandId(foreign));
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../../src/server/heartbeat_sweeper.hpp"
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records when the sweeper pinged and checked it
+class FakePeer : public HeartbeatSweeper::Peer {
+public:
+    void sendHeartbeat() override { pings.push_back(std::chrono::steady_clock::now()); }
+    void checkHeartbeat() override { checks.push_back(std::chrono::steady_clock::now()); }
+
+    std::vector<std::chrono::steady_clock::time_point> pings;
+    std::vector<std::chrono::steady_clock::time_point> checks;
+};
+
+} // namespace
+
+class HeartbeatSweeperTest : public ::testing::Test {
+protected:
+    boost::asio::io_context ioc;
+    // 8 buckets of 10ms; checks trail pings by 3 buckets
+    std::shared_ptr<HeartbeatSweeper> sweeper = std::make_shared<HeartbeatSweeper>(ioc, 80ms, 25ms, 8);
+
+    void runFor(std::chrono::milliseconds duration) {
+        ioc.restart();
+        ioc.run_for(duration);
+    }
+};
+
+TEST_F(HeartbeatSweeperTest, PingsOncePerIntervalAndChecksAfterTimeout) {
+    auto peer = std::make_shared<FakePeer>();
+    sweeper->join(peer);
+    EXPECT_EQ(sweeper->size(), 1u);
+    runFor(420ms);
+
+    ASSERT_GE(peer->pings.size(), 4u);
+    EXPECT_LE(peer->pings.size(), 6u);
+    for (std::size_t i = 1; i < peer->pings.size(); ++i) {
+        EXPECT_GE(peer->pings[i] - peer->pings[i - 1], 60ms);
+    }
+    // Every ping is followed by a check no sooner than the pong timeout
+    for (auto ping : peer->pings) {
+        auto check = std::find_if(peer->checks.begin(), peer->checks.end(), [ping](auto time) { return time > ping; });
+        if (check != peer->checks.end()) {
+            EXPECT_GE(*check - ping, 25ms);
+            EXPECT_LT(*check - ping, 80ms);
+        }
+    }
+}
+
+TEST_F(HeartbeatSweeperTest, SpreadsABurstAcrossBuckets) {
+    std::vector<std::shared_ptr<FakePeer>> peers;
+    for (int i = 0; i < 80; ++i) {
+        peers.push_back(std::make_shared<FakePeer>());
+        sweeper->join(peers.back());
+    }
+    // Drive sweeps by hand: one lap pings everyone once, ten per bucket
+    for (int bucket = 0; bucket < 8; ++bucket) {
+        std::size_t pinged_before = 0;
+        for (const auto& peer : peers) {
+            pinged_before += peer->pings.size();
+        }
+        sweeper->sweep();
+        std::size_t pinged_after = 0;
+        for (const auto& peer : peers) {
+            pinged_after += peer->pings.size();
+        }
+        EXPECT_EQ(pinged_after - pinged_before, 10u);
+    }
+    for (const auto& peer : peers) {
+        EXPECT_EQ(peer->pings.size(), 1u);
+    }
+}
+
+TEST_F(HeartbeatSweeperTest, LeavingAndDestroyedPeersAreNotPinged) {
+    auto leaving = std::make_shared<FakePeer>();
+    auto staying = std::make_shared<FakePeer>();
+    auto destroyed = std::make_shared<FakePeer>();
+    sweeper->join(leaving);
+    sweeper->join(staying);
+    sweeper->join(destroyed);
+    sweeper->leave(*leaving);
+    destroyed.reset();
+    EXPECT_EQ(sweeper->size(), 1u);
+    for (int i = 0; i < 8; ++i) {
+        sweeper->sweep();
+    }
+    EXPECT_TRUE(leaving->pings.empty());
+    EXPECT_EQ(staying->pings.size(), 1u);
+}
+
+TEST_F(HeartbeatSweeperTest, StopsTickingWhenEmpty) {
+    auto peer = std::make_shared<FakePeer>();
+    sweeper->join(peer);
+    sweeper->leave(*peer);
+    // run_for returns early once the tick timer has stopped
+    auto start = std::chrono::steady_clock::now();
+    runFor(1s);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+    EXPECT_TRUE(peer->pings.empty());
+}
@@ -0,0 +1,312 @@
+#include <gtest/gtest.h>
+#include "../../src/server/game_session.hpp"
+#include "../../src/server/in_memory_transport.hpp"
+#include "../../src/core/preflop_table.hpp"
+#include <boost/asio.hpp>
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+// Types of the messages waiting for a client, oldest first
+std::vector<std::string> messageTypes(InMemoryTransport& transport) {
+    std::vector<std::string> types;
+    for (const std::string& message : transport.drain()) {
+        types.push_back(nlohmann::json::parse(message).at("type").get<std::string>());
+    }
+    return types;
+}
+
+std::string playerId(InMemoryTransport& transport) {
+    std::string message;
+    EXPECT_TRUE(transport.receive(message));
+    return nlohmann::json::parse(message).at("payload").at("player_id").get<std::string>();
+}
+
+} // namespace
+
+class InMemoryTransportTest : public ::testing::Test {
+protected:
+    boost::asio::io_context ioc;
+    std::shared_ptr<GameSession> game = std::make_shared<GameSession>(ioc);
+
+    // Run the work the transports handed to the table's strand
+    void settle() {
+        ioc.restart();
+        ioc.poll();
+    }
+
+    std::shared_ptr<InMemoryTransport> connect() {
+        auto transport = std::make_shared<InMemoryTransport>();
+        transport->setHandler(game);
+        transport->start();
+        settle();
+        return transport;
+    }
+};
+
+TEST_F(InMemoryTransportTest, WelcomeOnStart) {
+    auto client = connect();
+    std::string message;
+    ASSERT_TRUE(client->receive(message));
+    auto json = nlohmann::json::parse(message);
+    EXPECT_EQ(json["type"], "welcome");
+    EXPECT_FALSE(json["payload"]["player_id"].get<std::string>().empty());
+    EXPECT_EQ(client->pending(), 0u);
+}
+
+TEST_F(InMemoryTransportTest, PingPong) {
+    auto client = connect();
+    client->drain();
+    client->deliver(R"({"type":"ping","payload":{}})");
+    settle();
+    EXPECT_EQ(messageTypes(*client), std::vector<std::string>{"pong"});
+}
+
+TEST_F(InMemoryTransportTest, MalformedMessageGetsError) {
+    auto client = connect();
+    client->drain();
+    client->deliver("{not json");
+    settle();
+    EXPECT_EQ(messageTypes(*client), std::vector<std::string>{"error"});
+}
+
+TEST_F(InMemoryTransportTest, FullHandOverProtocol) {
+    auto alice = connect();
+    auto bob = connect();
+    std::string alice_id = playerId(*alice);
+    std::string bob_id = playerId(*bob);
+
+    alice->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+    bob->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+    settle();
+    auto alice_types = messageTypes(*alice);
+    ASSERT_GE(alice_types.size(), 2u);
+    EXPECT_EQ(alice_types[0], "join_ack");
+    EXPECT_EQ(alice_types[1], "hand_started");
+
+    std::string message;
+    ASSERT_TRUE(bob->receive(message));
+    EXPECT_EQ(nlohmann::json::parse(message)["type"], "join_ack");
+    ASSERT_TRUE(bob->receive(message));
+    auto started = nlohmann::json::parse(message);
+    ASSERT_EQ(started["type"], "hand_started");
+    std::string hand_id = started["payload"]["hand_id"];
+    std::string to_act = started["payload"]["current_player_to_act"];
+    ASSERT_TRUE(to_act == alice_id || to_act == bob_id);
+
+    auto actor = to_act == alice_id ? alice : bob;
+    actor->deliver(nlohmann::json{{"type", "action"},
+                                  {"payload", {{"hand_id", hand_id}, {"action", "fold"}, {"amount", 0}}}}
+                       .dump());
+    settle();
+    auto other_types = messageTypes(to_act == alice_id ? *bob : *alice);
+    EXPECT_EQ(other_types.front(), "action_applied");
+    EXPECT_EQ(other_types.back(), "hand_completed");
+}
+
+TEST_F(InMemoryTransportTest, FirstToActIsAskedAtHandStart) {
+    auto alice = connect();
+    auto bob = connect();
+    std::string alice_id = playerId(*alice);
+    playerId(*bob);
+
+    alice->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+    bob->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+    settle();
+    std::vector<std::string> alice_messages = alice->drain();
+    std::vector<std::string> bob_messages = bob->drain();
+    ASSERT_GE(alice_messages.size(), 2u);
+    auto started = nlohmann::json::parse(alice_messages[1]);
+    ASSERT_EQ(started["type"], "hand_started");
+    std::string to_act = started["payload"]["current_player_to_act"];
+
+    // Only the player to act is asked, right after hand_started, without waiting for any action
+    auto& actor_messages = to_act == alice_id ? alice_messages : bob_messages;
+    auto& other_messages = to_act == alice_id ? bob_messages : alice_messages;
+    ASSERT_EQ(actor_messages.size(), 3u);
+    auto request = nlohmann::json::parse(actor_messages[2]);
+    EXPECT_EQ(request["type"], "action_request");
+    EXPECT_EQ(request["payload"]["hand_id"], started["payload"]["hand_id"]);
+    ASSERT_EQ(other_messages.size(), 2u);
+    EXPECT_EQ(nlohmann::json::parse(other_messages[1])["type"], "hand_started");
+}
+
+TEST_F(InMemoryTransportTest, HandCompletedReportsAllInEquity) {
+    // Every matchup is worth a quarter of the pot, so both players show 0.25
+    std::string path = ::testing::TempDir() + "in_memory_transport_test_equity_" + std::to_string(::getpid()) + ".bin";
+    constexpr std::size_t CLASSES = PreflopEquityTable::NUM_CLASSES;
+    constexpr std::size_t COMBOS = PreflopEquityTable::NUM_COMBOS;
+    PreflopEquityTable::write(path, std::vector<float>(CLASSES * CLASSES, 0.25f),
+                              std::vector<float>(COMBOS * COMBOS, 0.25f));
+    game->setPreflopTable(std::make_shared<const PreflopEquityTable>(path));
+    std::remove(path.c_str());
+
+    auto alice = connect();
+    auto bob = connect();
+    std::string alice_id = playerId(*alice);
+    std::string bob_id = playerId(*bob);
+    alice->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+    bob->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+    settle();
+    bob->drain();
+    nlohmann::json started;
+    for (const std::string& message : alice->drain()) {
+        auto json = nlohmann::json::parse(message);
+        if (json["type"] == "hand_started") {
+            started = json;
+        }
+    }
+    ASSERT_EQ(started["type"], "hand_started");
+    std::string to_act = started["payload"]["current_player_to_act"];
+    auto actor = to_act == alice_id ? alice : bob;
+    actor->deliver(nlohmann::json{{"type", "action"},
+                                  {"payload", {{"hand_id", started["payload"]["hand_id"]}, {"action", "fold"}, {"amount", 0}}}}
+                       .dump());
+    settle();
+
+    nlohmann::json completed;
+    for (const std::string& message : alice->drain()) {
+        auto json = nlohmann::json::parse(message);
+        if (json["type"] == "hand_completed") {
+            completed = json;
+        }
+    }
+    ASSERT_EQ(completed["type"], "hand_completed");
+    const auto& equity = completed["payload"]["all_in_equity"];
+    ASSERT_EQ(equity.size(), 2u);
+    for (const std::string& id : {alice_id, bob_id}) {
+        EXPECT_DOUBLE_EQ(equity[id]["equity"].get<double>(), 0.25);
+        EXPECT_TRUE(equity[id]["ev"].is_number());
+    }
+}
+
+TEST_F(InMemoryTransportTest, BroadcastSharesOnePayload) {
+    auto alice = connect();
+    auto bob = connect();
+    alice->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+    bob->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+    settle();
+    auto handStarted = [](const std::vector<Transport::Payload>& payloads) {
+        for (const auto& payload : payloads) {
+            if (nlohmann::json::parse(*payload)["type"] == "hand_started") {
+                return payload;
+            }
+        }
+        return Transport::Payload();
+    };
+    auto to_alice = handStarted(alice->drainPayloads());
+    auto to_bob = handStarted(bob->drainPayloads());
+    // hand_started is serialized once and both outboxes held the same buffer
+    ASSERT_NE(to_alice, nullptr);
+    EXPECT_EQ(to_alice, to_bob);
+    EXPECT_EQ(to_alice.use_count(), 2);
+}
+
+TEST_F(InMemoryTransportTest, CloseReportsDisconnect) {
+    auto alice = connect();
+    auto bob = connect();
+    alice->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+    bob->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+    settle();
+    bob->drain();
+    alice->close();
+    settle();
+    auto types = messageTypes(*bob);
+    ASSERT_FALSE(types.empty());
+    EXPECT_EQ(types.back(), "player_disconnected");
+}
+
+class ActionTimeoutTest : public InMemoryTransportTest {
+protected:
+    std::shared_ptr<InMemoryTransport> alice;
+    std::shared_ptr<InMemoryTransport> bob;
+    std::string hand_id;
+    std::shared_ptr<InMemoryTransport> actor; // asked to act first
+    std::shared_ptr<InMemoryTransport> other;
+    std::string actor_id;
+    nlohmann::json request; // the actor's action_request
+
+    void SetUp() override {
+        game = std::make_shared<GameSession>(ioc, 50);
+        alice = connect();
+        bob = connect();
+        std::string alice_id = playerId(*alice);
+        std::string bob_id = playerId(*bob);
+        alice->deliver(R"({"type":"join","payload":{"name":"alice"}})");
+        bob->deliver(R"({"type":"join","payload":{"name":"bob"}})");
+        settle();
+        for (const auto& client : {alice, bob}) {
+            for (const std::string& message : client->drain()) {
+                auto json = nlohmann::json::parse(message);
+                if (json["type"] == "hand_started") {
+                    hand_id = json["payload"]["hand_id"];
+                    actor_id = json["payload"]["current_player_to_act"];
+                } else if (json["type"] == "action_request") {
+                    request = json;
+                }
+            }
+        }
+        ASSERT_FALSE(actor_id.empty());
+        actor = actor_id == alice_id ? alice : bob;
+        other = actor_id == alice_id ? bob : alice;
+    }
+
+    // Messages to client once the table has had time to run out one action clock
+    std::vector<nlohmann::json> afterTimeout(InMemoryTransport& client) {
+        ioc.restart();
+        ioc.run_for(std::chrono::milliseconds(150));
+        std::vector<nlohmann::json> messages;
+        for (const std::string& message : client.drain()) {
+            messages.push_back(nlohmann::json::parse(message));
+        }
+        return messages;
+    }
+};
+
+TEST_F(ActionTimeoutTest, ChecksWhenNothingIsOwed) {
+    // Blinds are not posted, so the first actor owes nothing
+    ASSERT_EQ(request["type"], "action_request");
+    EXPECT_EQ(request["payload"]["timeout_ms"], 50);
+    EXPECT_EQ(request["payload"]["call_amount"], 0);
+
+    auto seen = afterTimeout(*other);
+    ASSERT_FALSE(seen.empty());
+    EXPECT_EQ(seen[0]["type"], "action_applied");
+    EXPECT_EQ(seen[0]["payload"]["player_id"], actor_id);
+    EXPECT_EQ(seen[0]["payload"]["action"], "call");
+    EXPECT_EQ(seen[0]["payload"]["amount"], 0);
+    // The turn passes on and the other player's clock starts
+    ASSERT_GE(seen.size(), 2u);
+    EXPECT_EQ(seen[1]["type"], "action_request");
+}
+
+TEST_F(ActionTimeoutTest, FoldsWhenFacingABet) {
+    actor->deliver(nlohmann::json{{"type", "action"},
+                                  {"payload", {{"hand_id", hand_id}, {"action", "raise"}, {"amount", 8}}}}
+                       .dump());
+    settle();
+    actor->drain();
+
+    auto seen = afterTimeout(*actor);
+    ASSERT_GE(seen.size(), 2u);
+    EXPECT_EQ(seen.front()["type"], "action_applied");
+    EXPECT_NE(seen.front()["payload"]["player_id"], actor_id);
+    EXPECT_EQ(seen.front()["payload"]["action"], "fold");
+    EXPECT_EQ(seen.back()["type"], "hand_completed");
+}
+
+TEST_F(ActionTimeoutTest, AnswerInTimeStopsTheClock) {
+    actor->deliver(nlohmann::json{{"type", "action"},
+                                  {"payload", {{"hand_id", hand_id}, {"action", "fold"}, {"amount", 0}}}}
+                       .dump());
+    settle();
+    actor->drain();
+    // The hand is over, so nothing is left to time out
+    auto seen = afterTimeout(*actor);
+    EXPECT_TRUE(seen.empty());
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include "../../src/server/message_writer.hpp"
+#include "../../src/core/hand.hpp"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// The writers must reproduce, byte for byte, the nlohmann DOM the server used to
+// build these messages with; the references below are that construction.
+
+namespace {
+
+Player makePlayer(const std::string& id, int stack, const char* card1, const char* card2) {
+    Player player{};
+    player.id = id;
+    player.stack = stack;
+    player.hole_cards.push_back(Card(card1));
+    player.hole_cards.push_back(Card(card2));
+    return player;
+}
+
+} // namespace
+
+TEST(JsonWriterTest, EscapesLikeDump) {
+    std::string tricky = "quote\" backslash\\ newline\n tab\t bell\a nul";
+    tricky += '\0';
+    tricky += "\x1f del\x7f utf8 \xc3\xa9";
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.key("a");
+    writer.beginArray();
+    writer.value(tricky);
+    writer.value(-42);
+    writer.null();
+    writer.beginObject();
+    writer.endObject();
+    writer.beginArray();
+    writer.endArray();
+    writer.endArray();
+    writer.key("b");
+    writer.value(int64_t{9007199254740993});
+    writer.endObject();
+
+    nlohmann::json reference = {
+        {"a", {tricky, -42, nullptr, nlohmann::json::object(), nlohmann::json::array()}},
+        {"b", int64_t{9007199254740993}},
+    };
+    EXPECT_EQ(out, reference.dump());
+}
+
+TEST(JsonWriterTest, DoublesLikeDump) {
+    const std::vector<double> numbers = {0.5, 0.5234, 12.0, -3.25, 0.0, -0.0, 0.0001, 123456.78, 1.0 / 3.0};
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginArray();
+    for (double number : numbers) {
+        writer.value(number);
+    }
+    writer.value(std::nan(""));
+    writer.endArray();
+
+    nlohmann::json reference = nlohmann::json::array();
+    for (double number : numbers) {
+        reference.push_back(number);
+    }
+    reference.push_back(std::nan(""));
+    EXPECT_EQ(out, reference.dump());
+}
+
+TEST(MessageWriterTest, HandStartedMatchesDom) {
+    Player alice = makePlayer("b-alice", 398, "As", "Kd");
+    Player bob = makePlayer("a-bob", 396, "2c", "Th");
+    std::vector<Player*> players = {&alice, &bob};
+    auto payload = messages::handStarted("table-1", 7, players, 2, 4, 1, alice.id, 4);
+
+    nlohmann::json players_array = nlohmann::json::array();
+    for (Player* player : players) {
+        nlohmann::json cards = nlohmann::json::array();
+        for (const Card& card : player->hole_cards) {
+            cards.push_back(card.toString());
+        }
+        players_array.push_back({{"player_id", player->id}, {"stack", player->stack}, {"hole_cards", cards}});
+    }
+    nlohmann::json reference = {
+        {"type", "hand_started"},
+        {"payload", {
+            {"hand_id", poker::formatHandId(7)},
+            {"players", players_array},
+            {"small_blind", 2},
+            {"big_blind", 4},
+            {"dealer_position", 1},
+            {"current_player_to_act", alice.id},
+            {"min_raise", 4}
+        }},
+        {"table_id", "table-1"}
+    };
+    EXPECT_EQ(*payload, reference.dump());
+}
+
+TEST(MessageWriterTest, ActionRequestMatchesDom) {
+    auto payload = messages::actionRequest("table-1", 12345678901ull, 2, 4, 398, 30000);
+    nlohmann::json reference = {
+        {"type", "action_request"},
+        {"payload", {
+            {"hand_id", poker::formatHandId(12345678901ull)},
+            {"possible_actions", {"fold", "call", "raise"}},
+            {"call_amount", 2},
+            {"min_raise", 4},
+            {"max_raise", 398},
+            {"timeout_ms", 30000}
+        }},
+        {"table_id", "table-1"}
+    };
+    EXPECT_EQ(*payload, reference.dump());
+}
+
+TEST(MessageWriterTest, ActionAppliedMatchesDom) {
+    auto payload = messages::actionApplied("table-1", 3, "p1", Action::RAISE, 20, 380, 26, "");
+    nlohmann::json reference = {
+        {"type", "action_applied"},
+        {"payload", {
+            {"hand_id", poker::formatHandId(3)},
+            {"player_id", "p1"},
+            {"action", "raise"},
+            {"amount", 20},
+            {"new_stack", 380},
+            {"pot", 26},
+            {"next_player_to_act", ""}
+        }},
+        {"table_id", "table-1"}
+    };
+    EXPECT_EQ(*payload, reference.dump());
+}
+
+TEST(MessageWriterTest, HandCompletedMatchesDom) {
+    Player alice = makePlayer("zed", 410, "As", "Kd");
+    Player bob = makePlayer("amy", 390, "2c", "Th");
+    std::vector<Player*> players = {&alice, nullptr, &bob};
+    std::vector<messages::Winner> winners = {{&alice.id, 11}, {&bob.id, 10}};
+    auto payload = messages::handCompleted("table-1", 9, winners, players);
+
+    nlohmann::json winners_json = nlohmann::json::array();
+    nlohmann::json distribution = nlohmann::json::array();
+    for (const auto& winner : winners) {
+        winners_json.push_back({{"player_id", *winner.player_id}, {"amount_won", winner.amount}, {"hand_rank", "unknown"}});
+        distribution.push_back({{"pot_index", 0}, {"winner_id", *winner.player_id}, {"amount", winner.amount}});
+    }
+    nlohmann::json stacks = nlohmann::json::object();
+    stacks[alice.id] = alice.stack;
+    stacks[bob.id] = bob.stack;
+    nlohmann::json reference = {
+        {"type", "hand_completed"},
+        {"payload", {
+            {"hand_id", poker::formatHandId(9)},
+            {"winners", winners_json},
+            {"pot_distribution", distribution},
+            {"updated_stacks", stacks}
+        }},
+        {"table_id", "table-1"}
+    };
+    EXPECT_EQ(*payload, reference.dump());
+
+    // No winners: empty arrays, as for a hand the server could not settle
+    auto empty = messages::handCompleted("table-1", 9, {}, players);
+    reference["payload"]["winners"] = nlohmann::json::array();
+    reference["payload"]["pot_distribution"] = nlohmann::json::array();
+    EXPECT_EQ(*empty, reference.dump());
+
+    // Equities are keyed by player id like updated_stacks
+    std::vector<messages::AllInEquity> equities = {{&alice.id, 0.6543, 3.09}, {&bob.id, 0.3457, -3.09}};
+    auto with_equity = messages::handCompleted("table-1", 9, {}, players, equities);
+    reference["payload"]["all_in_equity"] = {
+        {alice.id, {{"equity", 0.6543}, {"ev", 3.09}}},
+        {bob.id, {{"equity", 0.3457}, {"ev", -3.09}}},
+    };
+    EXPECT_EQ(*with_equity, reference.dump());
+}
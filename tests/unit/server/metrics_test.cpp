@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "../../src/server/metrics.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// Metrics are process-wide, so tests compare before and after
+
+namespace {
+
+// Value of the sample line starting with series, or -1 if it is missing
+double sample(const std::string& text, const std::string& series) {
+    std::size_t at = text.find("\n" + series + " ");
+    if (at == std::string::npos) {
+        return -1;
+    }
+    return std::stod(text.substr(at + series.size() + 2));
+}
+
+} // namespace
+
+TEST(MetricsTest, CountersMergeEveryThreadIncludingExitedOnes) {
+    std::uint64_t before = metrics::value(metrics::Counter::HANDS_STARTED);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; ++i) {
+                metrics::increment(metrics::Counter::HANDS_STARTED);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    metrics::increment(metrics::Counter::HANDS_STARTED, 5);
+
+    EXPECT_EQ(metrics::value(metrics::Counter::HANDS_STARTED), before + 4005);
+}
+
+TEST(MetricsTest, CountReceivedUsesTheMessageType) {
+    std::uint64_t actions = metrics::value(metrics::Counter::MESSAGES_RECEIVED_ACTION);
+    std::uint64_t invalid = metrics::value(metrics::Counter::MESSAGES_RECEIVED_INVALID);
+
+    metrics::countReceived(parseClientMessage(R"({"type":"action","payload":{"action":"fold"}})"));
+    metrics::countReceived(parseClientMessage("not json"));
+
+    EXPECT_EQ(metrics::value(metrics::Counter::MESSAGES_RECEIVED_ACTION), actions + 1);
+    EXPECT_EQ(metrics::value(metrics::Counter::MESSAGES_RECEIVED_INVALID), invalid + 1);
+}
+
+TEST(MetricsTest, HistogramBucketsAreCumulative) {
+    const std::string name = "poker_write_batch_messages";
+    std::string before = metrics::render();
+
+    metrics::observe(metrics::Histogram::WRITE_BATCH_SIZE, 1);
+    metrics::observe(metrics::Histogram::WRITE_BATCH_SIZE, 3);
+    metrics::observe(metrics::Histogram::WRITE_BATCH_SIZE, 1000);
+
+    std::string after = metrics::render();
+    auto delta = [&](const std::string& series) { return sample(after, series) - sample(before, series); };
+    EXPECT_EQ(delta(name + "_bucket{le=\"1\"}"), 1);
+    EXPECT_EQ(delta(name + "_bucket{le=\"2\"}"), 1);
+    EXPECT_EQ(delta(name + "_bucket{le=\"4\"}"), 2);
+    EXPECT_EQ(delta(name + "_bucket{le=\"256\"}"), 2);
+    EXPECT_EQ(delta(name + "_bucket{le=\"+Inf\"}"), 3);
+    EXPECT_EQ(delta(name + "_count"), 3);
+    EXPECT_EQ(delta(name + "_sum"), 1004);
+}
+
+TEST(MetricsTest, RenderWritesHelpAndTypeOncePerFamily) {
+    std::string text = metrics::render();
+
+    EXPECT_NE(text.find("# TYPE poker_messages_received_total counter\n"), std::string::npos);
+    EXPECT_EQ(text.find("# TYPE poker_messages_received_total counter\n"),
+              text.rfind("# TYPE poker_messages_received_total counter\n"));
+    EXPECT_GE(sample(text, "poker_messages_received_total{type=\"join\"}"), 0);
+    EXPECT_GE(sample(text, "poker_messages_received_total{type=\"top_up\"}"), 0);
+    EXPECT_NE(text.find("# TYPE poker_action_latency_microseconds histogram\n"), std::string::npos);
+}
+
+TEST(MetricsTest, GaugesAreReadAtScrapeAndRemovedByOwner) {
+    int owner = 0;
+    double reading = 2;
+    metrics::addGauge(&owner, "test_gauge", "A gauge for the test", [&reading]() { return reading; });
+
+    EXPECT_EQ(sample(metrics::render(), "test_gauge"), 2);
+    reading = 7.5;
+    EXPECT_EQ(sample(metrics::render(), "test_gauge"), 7.5);
+
+    metrics::removeGauges(&owner);
+    EXPECT_EQ(metrics::render().find("test_gauge"), std::string::npos);
+}
+
+TEST(MetricsTest, LatencyQuantilesAreWithinBucketPrecision) {
+    // 1us to 1000us, recorded from a thread that then exits
+    std::thread recorder([]() {
+        for (int us = 1; us <= 1000; ++us) {
+            metrics::record(metrics::Stage::SERIALIZE, metrics::INVALID_MESSAGE, std::chrono::microseconds(us));
+        }
+    });
+    recorder.join();
+
+    auto summary = metrics::latency(metrics::Stage::SERIALIZE, metrics::INVALID_MESSAGE);
+    auto near = [](std::chrono::nanoseconds actual, std::chrono::nanoseconds expected) {
+        return actual >= expected && actual <= expected + expected / 31;
+    };
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_TRUE(near(summary.p50, 500us)) << summary.p50.count();
+    EXPECT_TRUE(near(summary.p99, 990us)) << summary.p99.count();
+    EXPECT_TRUE(near(summary.p999, 999us)) << summary.p999.count();
+    EXPECT_EQ(summary.max, std::chrono::steady_clock::duration(1000us));
+}
+
+TEST(MetricsTest, LatencyIsExactForSmallValuesAndClampsHugeOnes) {
+    metrics::record(metrics::Stage::WRITE, metrics::INVALID_MESSAGE, 17ns);
+    metrics::record(metrics::Stage::WRITE, metrics::INVALID_MESSAGE, -5ns);
+    metrics::record(metrics::Stage::WRITE, metrics::INVALID_MESSAGE, std::chrono::hours(2));
+
+    auto summary = metrics::latency(metrics::Stage::WRITE, metrics::INVALID_MESSAGE);
+    EXPECT_EQ(summary.count, 3u);
+    EXPECT_EQ(summary.p50, std::chrono::steady_clock::duration(17ns));
+    EXPECT_EQ(summary.max, std::chrono::steady_clock::duration(std::chrono::hours(2)));
+}
+
+TEST(MetricsTest, ScopesFollowAMessageThroughThePipeline) {
+    auto type = static_cast<std::size_t>(ClientMessageType::PING);
+    auto parses = metrics::latency(metrics::Stage::PARSE, type).count;
+    auto handles = metrics::latency(metrics::Stage::HANDLE, type).count;
+
+    // Outside a Receiving scope nothing is timed
+    ClientMessage untimed = parseClientMessage(R"({"type":"ping","payload":{}})");
+    metrics::traceReceived(untimed);
+    EXPECT_EQ(untimed.received, std::chrono::steady_clock::time_point());
+    {
+        metrics::Handling handling(untimed);
+        EXPECT_FALSE(metrics::currentTrace());
+    }
+
+    ClientMessage message = parseClientMessage(R"({"type":"ping","payload":{}})");
+    auto received = std::chrono::steady_clock::now() - 5ms;
+    {
+        metrics::Receiving receiving(received);
+        metrics::traceReceived(message);
+    }
+    EXPECT_EQ(message.received, received);
+    {
+        metrics::Handling handling(message);
+        EXPECT_EQ(metrics::currentTrace().type, type);
+        EXPECT_EQ(metrics::currentTrace().received, received);
+        metrics::Serializing serializing;
+        std::this_thread::sleep_for(2ms);
+    }
+    EXPECT_FALSE(metrics::currentTrace());
+
+    EXPECT_EQ(metrics::latency(metrics::Stage::PARSE, type).count, parses + 1);
+    EXPECT_GE(metrics::latency(metrics::Stage::PARSE, type).max, std::chrono::steady_clock::duration(5ms));
+    EXPECT_EQ(metrics::latency(metrics::Stage::HANDLE, type).count, handles + 1);
+    EXPECT_GE(metrics::latency(metrics::Stage::SERIALIZE, type).max, std::chrono::steady_clock::duration(2ms));
+}
+
+TEST(MetricsTest, RenderWritesLatencySummaries) {
+    metrics::record(metrics::Stage::END_TO_END, static_cast<std::size_t>(ClientMessageType::ACTION), 250us);
+    std::string text = metrics::render();
+
+    EXPECT_NE(text.find("# TYPE poker_message_latency_microseconds summary\n"), std::string::npos);
+    EXPECT_GT(sample(text, "poker_message_latency_microseconds{stage=\"end_to_end\",type=\"action\",quantile=\"0.99\"}"), 0);
+    EXPECT_GE(sample(text, "poker_message_latency_microseconds_count{stage=\"end_to_end\",type=\"action\"}"), 1);
+    EXPECT_GE(sample(text, "poker_message_latency_max_microseconds{stage=\"end_to_end\",type=\"action\"}"), 250);
+}
@@ -0,0 +1,359 @@
+#include <gtest/gtest.h>
+#include "../../src/server/table_registry.hpp"
+#include "../../src/server/in_memory_transport.hpp"
+#include <boost/asio.hpp>
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<nlohmann::json> messages(InMemoryTransport& transport) {
+    std::vector<nlohmann::json> parsed;
+    for (const std::string& message : transport.drain()) {
+        parsed.push_back(nlohmann::json::parse(message));
+    }
+    return parsed;
+}
+
+const nlohmann::json* findType(const std::vector<nlohmann::json>& parsed, const std::string& type) {
+    for (const auto& json : parsed) {
+        if (json["type"] == type) {
+            return &json;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+class TableRegistryTest : public ::testing::Test {
+protected:
+    boost::asio::io_context ioc;
+    std::shared_ptr<TableRegistry> registry = std::make_shared<TableRegistry>(ioc);
+
+    // Run the work the registry handed to table strands
+    void settle() {
+        ioc.restart();
+        ioc.poll();
+    }
+
+    std::shared_ptr<InMemoryTransport> connect(std::shared_ptr<TableRegistry> handler) {
+        auto transport = std::make_shared<InMemoryTransport>();
+        transport->setHandler(handler);
+        transport->start();
+        return transport;
+    }
+
+    std::shared_ptr<InMemoryTransport> connect() { return connect(registry); }
+
+    // Joins and returns the table_id of the join_ack
+    std::string join(InMemoryTransport& client, const std::string& name) {
+        client.drain();
+        client.deliver(nlohmann::json{{"type", "join"}, {"payload", {{"name", name}}}}.dump());
+        settle();
+        auto parsed = messages(client);
+        const nlohmann::json* ack = findType(parsed, "join_ack");
+        EXPECT_NE(ack, nullptr);
+        return ack ? (*ack)["table_id"].get<std::string>() : std::string();
+    }
+};
+
+TEST_F(TableRegistryTest, WelcomeHasNoTableBeforeJoin) {
+    auto client = connect();
+    auto parsed = messages(*client);
+    ASSERT_EQ(parsed.size(), 1u);
+    EXPECT_EQ(parsed[0]["type"], "welcome");
+    EXPECT_TRUE(parsed[0]["table_id"].is_null());
+    EXPECT_EQ(registry->stats().tables, 0u);
+}
+
+TEST_F(TableRegistryTest, JoinsFillTablesTwoAtATime) {
+    std::vector<std::shared_ptr<InMemoryTransport>> clients;
+    std::vector<std::string> table_ids;
+    for (int i = 0; i < 5; ++i) {
+        clients.push_back(connect());
+        table_ids.push_back(join(*clients.back(), "P" + std::to_string(i)));
+    }
+    EXPECT_EQ(table_ids[0], table_ids[1]);
+    EXPECT_EQ(table_ids[2], table_ids[3]);
+    EXPECT_NE(table_ids[0], table_ids[2]);
+    EXPECT_NE(table_ids[4], table_ids[0]);
+    EXPECT_NE(table_ids[4], table_ids[2]);
+
+    auto stats = registry->stats();
+    EXPECT_EQ(stats.tables, 3u);
+    EXPECT_EQ(stats.seated_players, 5u);
+    EXPECT_EQ(stats.connections, 5u);
+    EXPECT_EQ(stats.active_hands, 2u);
+    EXPECT_GE(stats.state_bytes, 3 * sizeof(GameSession) + 5 * sizeof(Player));
+    EXPECT_NE(registry->findTable(table_ids[0]), nullptr);
+    EXPECT_EQ(registry->findTable("missing"), nullptr);
+}
+
+TEST_F(TableRegistryTest, StateBytesCountHeapMembers) {
+    auto short_name = connect();
+    join(*short_name, "P");
+    std::size_t before = registry->stats().state_bytes;
+
+    // A name too long for the string's inline buffer is counted
+    auto long_name = connect();
+    join(*long_name, std::string(200, 'x'));
+    EXPECT_GE(registry->stats().state_bytes, before + sizeof(Player) + 200);
+}
+
+TEST_F(TableRegistryTest, TablesAreIsolated) {
+    auto a1 = connect();
+    auto a2 = connect();
+    auto b1 = connect();
+    auto b2 = connect();
+    std::string table_a = join(*a1, "A1");
+    join(*a2, "A2");
+    std::string table_b = join(*b1, "B1");
+    join(*b2, "B2");
+    a1->drain();
+    a2->drain();
+    b1->drain();
+    b2->drain();
+
+    // Traffic at table A carries its id and never reaches table B
+    a1->deliver(R"({"type":"ping","payload":{}})");
+    settle();
+    auto parsed = messages(*a1);
+    ASSERT_EQ(parsed.size(), 1u);
+    EXPECT_EQ(parsed[0]["type"], "pong");
+    EXPECT_EQ(parsed[0]["table_id"], table_a);
+    EXPECT_EQ(b1->pending(), 0u);
+    EXPECT_EQ(b2->pending(), 0u);
+
+    auto before = registry->findTable(table_b);
+    ASSERT_NE(before, nullptr);
+    EXPECT_TRUE(before->hasActiveHand());
+}
+
+TEST_F(TableRegistryTest, ReconnectReturnsToOriginalTable) {
+    auto a1 = connect();
+    auto a2 = connect();
+    auto b1 = connect();
+    std::string player_id = messages(*a1)[0]["payload"]["player_id"].get<std::string>();
+    std::string table_a = join(*a1, "A1");
+    join(*a2, "A2");
+    join(*b1, "B1");
+
+    a1->close();
+    settle();
+    EXPECT_EQ(registry->stats().connections, 2u);
+
+    // Table B has a free seat, but the seat held at table A wins
+    auto again = connect();
+    again->drain();
+    again->deliver(nlohmann::json{{"type", "join"}, {"payload", {{"name", "A1"}, {"player_id", player_id}}}}.dump());
+    settle();
+    auto parsed = messages(*again);
+    const nlohmann::json* ack = findType(parsed, "join_ack");
+    ASSERT_NE(ack, nullptr);
+    EXPECT_EQ((*ack)["table_id"], table_a);
+    EXPECT_EQ((*ack)["payload"]["player_id"], player_id);
+    EXPECT_EQ(registry->stats().seated_players, 3u);
+}
+
+TEST_F(TableRegistryTest, LivePlayersIdIsNotAReconnect) {
+    auto a1 = connect();
+    auto a2 = connect();
+    auto b1 = connect();
+    std::string victim_id = messages(*a1)[0]["payload"]["player_id"].get<std::string>();
+    std::string own_id = messages(*b1)[0]["payload"]["player_id"].get<std::string>();
+    std::string table_a = join(*a1, "A1");
+    join(*a2, "A2");
+    a1->drain();
+
+    // A join naming a connected player is seated as the new player it is
+    b1->drain();
+    b1->deliver(nlohmann::json{{"type", "join"}, {"payload", {{"name", "B1"}, {"player_id", victim_id}}}}.dump());
+    settle();
+    auto parsed = messages(*b1);
+    const nlohmann::json* ack = findType(parsed, "join_ack");
+    ASSERT_NE(ack, nullptr);
+    EXPECT_NE((*ack)["table_id"], table_a);
+    EXPECT_EQ((*ack)["payload"]["player_id"], own_id);
+    EXPECT_EQ(findType(messages(*a1), "player_reconnected"), nullptr);
+
+    // The victim's route survives the impostor leaving, so a real reconnect still works
+    b1->close();
+    settle();
+    a1->close();
+    settle();
+    auto again = connect();
+    again->drain();
+    again->deliver(nlohmann::json{{"type", "join"}, {"payload", {{"name", "A1"}, {"player_id", victim_id}}}}.dump());
+    settle();
+    parsed = messages(*again);
+    ack = findType(parsed, "join_ack");
+    ASSERT_NE(ack, nullptr);
+    EXPECT_EQ((*ack)["table_id"], table_a);
+    EXPECT_EQ((*ack)["payload"]["player_id"], victim_id);
+    EXPECT_EQ(registry->stats().seated_players, 3u);
+}
+
+TEST_F(TableRegistryTest, LosingAReconnectRaceUnroutesTheConnection) {
+    auto a1 = connect();
+    auto a2 = connect();
+    std::string player_id = messages(*a1)[0]["payload"]["player_id"].get<std::string>();
+    join(*a1, "A1");
+    join(*a2, "A2");
+    a1->close();
+    settle();
+
+    // Both are routed as reconnects before the table runs either
+    auto first = connect();
+    auto second = connect();
+    first->drain();
+    second->drain();
+    std::string reclaim = nlohmann::json{{"type", "join"}, {"payload", {{"name", "A1"}, {"player_id", player_id}}}}.dump();
+    first->deliver(reclaim);
+    second->deliver(reclaim);
+    settle();
+    EXPECT_NE(findType(messages(*first), "join_ack"), nullptr);
+    auto parsed = messages(*second);
+    const nlohmann::json* error = findType(parsed, "error");
+    ASSERT_NE(error, nullptr);
+    EXPECT_EQ((*error)["payload"]["code"], "reconnect_failed");
+
+    // The loser can still join as itself
+    EXPECT_FALSE(join(*second, "B1").empty());
+    EXPECT_EQ(registry->stats().seated_players, 3u);
+}
+
+TEST_F(TableRegistryTest, RemovedPlayersAreForgotten) {
+    auto quick = std::make_shared<TableRegistry>(ioc, 0, 30000, 10, 10);
+    auto a1 = connect(quick);
+    auto b1 = connect(quick);
+    join(*a1, "A1");
+    join(*b1, "B1");
+    EXPECT_EQ(quick->stats().tracked_players, 2u);
+
+    // Once grace and removal expire the registry drops its route back to the table
+    a1->close();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (quick->stats().tracked_players > 1 && std::chrono::steady_clock::now() < deadline) {
+        ioc.restart();
+        ioc.run_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(quick->stats().tracked_players, 1u);
+    EXPECT_NE(findType(messages(*b1), "player_removed"), nullptr);
+}
+
+TEST_F(TableRegistryTest, DeckSeedIsLoggedOnlyForReplay) {
+    // The seed and a hand id predict the deal, so tables keep it to themselves by default
+    auto quiet = connect();
+    testing::internal::CaptureStdout();
+    join(*quiet, "P1");
+    EXPECT_EQ(testing::internal::GetCapturedStdout().find("deck seed"), std::string::npos);
+
+    auto replay = std::make_shared<TableRegistry>(ioc, 0, 30000, 30000, 60000, 1, nullptr, true);
+    auto logged = connect(replay);
+    testing::internal::CaptureStdout();
+    join(*logged, "P2");
+    std::string output = testing::internal::GetCapturedStdout();
+#ifndef POKER_SECURE_DECK
+    EXPECT_NE(output.find("deck seed"), std::string::npos);
+#else
+    EXPECT_NE(output.find("cannot be replayed"), std::string::npos);
+#endif
+}
+
+TEST_F(TableRegistryTest, ServerFullWhenMaxTablesReached) {
+    auto limited = std::make_shared<TableRegistry>(ioc, 1);
+    auto c1 = connect(limited);
+    auto c2 = connect(limited);
+    auto c3 = connect(limited);
+    join(*c1, "P1");
+    join(*c2, "P2");
+    c3->drain();
+    c3->deliver(R"({"type":"join","payload":{"name":"P3"}})");
+    settle();
+    auto parsed = messages(*c3);
+    ASSERT_EQ(parsed.size(), 1u);
+    EXPECT_EQ(parsed[0]["type"], "error");
+    EXPECT_EQ(parsed[0]["payload"]["code"], "server_full");
+    EXPECT_EQ(limited->stats().tables, 1u);
+}
+
+TEST_F(TableRegistryTest, UnroutedConnectionRejectsActions) {
+    auto client = connect();
+    client->drain();
+    client->deliver(R"({"type":"action","payload":{"action":"fold"}})");
+    settle();
+    auto parsed = messages(*client);
+    ASSERT_EQ(parsed.size(), 1u);
+    EXPECT_EQ(parsed[0]["payload"]["code"], "unauthorized");
+
+    client->deliver(R"({"type":"ping","payload":{}})");
+    settle();
+    parsed = messages(*client);
+    ASSERT_EQ(parsed.size(), 1u);
+    EXPECT_EQ(parsed[0]["type"], "pong");
+}
+
+TEST_F(TableRegistryTest, ConcurrentJoinsOnThreadPool) {
+    constexpr int kThreads = 4;
+    constexpr int kClientsPerThread = 10;
+    auto guard = boost::asio::make_work_guard(ioc);
+    std::vector<std::thread> io_threads;
+    for (int t = 0; t < kThreads; ++t) {
+        io_threads.emplace_back([this] { ioc.run(); });
+    }
+
+    // Clients join from several threads while the tables run on the pool
+    std::vector<std::vector<std::shared_ptr<InMemoryTransport>>> clients(kThreads);
+    std::vector<std::thread> joiners;
+    for (int t = 0; t < kThreads; ++t) {
+        joiners.emplace_back([this, t, &clients] {
+            for (int i = 0; i < kClientsPerThread; ++i) {
+                auto client = connect();
+                client->deliver(nlohmann::json{{"type", "join"},
+                                               {"payload", {{"name", "P" + std::to_string(t) + "_" + std::to_string(i)}}}}
+                                    .dump());
+                clients[t].push_back(client);
+            }
+        });
+    }
+    for (auto& joiner : joiners) {
+        joiner.join();
+    }
+
+    constexpr std::size_t kClients = kThreads * kClientsPerThread;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (registry->stats().active_hands < kClients / 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    guard.reset();
+    ioc.stop();
+    for (auto& thread : io_threads) {
+        thread.join();
+    }
+
+    // Every join was seated and no table took more than two players
+    std::map<std::string, int> seats_per_table;
+    for (auto& per_thread : clients) {
+        for (auto& client : per_thread) {
+            auto parsed = messages(*client);
+            const nlohmann::json* ack = findType(parsed, "join_ack");
+            ASSERT_NE(ack, nullptr);
+            ++seats_per_table[(*ack)["table_id"].get<std::string>()];
+        }
+    }
+    EXPECT_EQ(seats_per_table.size(), kClients / 2);
+    for (const auto& [table_id, seats] : seats_per_table) {
+        EXPECT_EQ(seats, 2) << table_id;
+    }
+    auto stats = registry->stats();
+    EXPECT_EQ(stats.tables, kClients / 2);
+    EXPECT_EQ(stats.seated_players, kClients);
+    EXPECT_EQ(stats.active_hands, kClients / 2);
+}
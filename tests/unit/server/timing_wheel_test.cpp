@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "../../src/server/timing_wheel.hpp"
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class TimingWheelTest : public ::testing::Test {
+protected:
+    boost::asio::io_context ioc;
+    // 1ms ticks put level 1 at 64ms, so cascading shows up in short tests
+    std::shared_ptr<TimingWheel> wheel = std::make_shared<TimingWheel>(ioc, 1ms);
+
+    // Run until the wheel has nothing left to do or limit passes
+    void runFor(std::chrono::milliseconds limit) {
+        ioc.restart();
+        ioc.run_for(limit);
+    }
+};
+
+TEST_F(TimingWheelTest, FiresOnItsExecutorNotBefore) {
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration fired_after{};
+    auto strand = boost::asio::make_strand(ioc);
+    wheel->schedule(20ms, strand, [&]() {
+        EXPECT_TRUE(strand.running_in_this_thread());
+        fired_after = std::chrono::steady_clock::now() - start;
+    });
+    EXPECT_EQ(wheel->pending(), 1u);
+    runFor(500ms);
+    EXPECT_GE(fired_after, 20ms);
+    EXPECT_EQ(wheel->pending(), 0u);
+}
+
+TEST_F(TimingWheelTest, CancelledNeverFires) {
+    bool fired = false;
+    auto handle = wheel->schedule(10ms, ioc.get_executor(), [&]() { fired = true; });
+    EXPECT_TRUE(wheel->cancel(handle));
+    EXPECT_FALSE(wheel->cancel(handle));
+    EXPECT_EQ(wheel->pending(), 0u);
+    runFor(50ms);
+    EXPECT_FALSE(fired);
+}
+
+TEST_F(TimingWheelTest, StaleHandleDoesNotCancelReusedEntry) {
+    auto stale = wheel->schedule(10ms, ioc.get_executor(), []() {});
+    ASSERT_TRUE(wheel->cancel(stale));
+    // Reuses the freed entry under a new generation
+    bool fired = false;
+    wheel->schedule(10ms, ioc.get_executor(), [&]() { fired = true; });
+    EXPECT_FALSE(wheel->cancel(stale));
+    runFor(200ms);
+    EXPECT_TRUE(fired);
+}
+
+TEST_F(TimingWheelTest, FiresInDeadlineOrderAcrossLevels) {
+    // Delays on both sides of level 0's 64 ticks, armed out of order
+    std::vector<int> delays = {150, 5, 70, 63, 64, 200, 1, 130};
+    std::vector<int> order;
+    for (int delay : delays) {
+        wheel->schedule(std::chrono::milliseconds(delay), ioc.get_executor(), [&order, delay]() { order.push_back(delay); });
+    }
+    runFor(1s);
+    std::vector<int> expected = delays;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(order, expected);
+}
+
+TEST_F(TimingWheelTest, ManyDeadlinesShareOneWheel) {
+    int fired = 0;
+    std::vector<TimingWheel::Handle> handles;
+    for (int i = 0; i < 10000; ++i) {
+        handles.push_back(wheel->schedule(std::chrono::milliseconds(1 + i % 100), ioc.get_executor(), [&fired]() { ++fired; }));
+    }
+    // Cancel every other one
+    for (std::size_t i = 0; i < handles.size(); i += 2) {
+        EXPECT_TRUE(wheel->cancel(handles[i]));
+    }
+    EXPECT_EQ(wheel->pending(), 5000u);
+    runFor(2s);
+    EXPECT_EQ(fired, 5000);
+    EXPECT_EQ(wheel->pending(), 0u);
+}
+
+TEST_F(TimingWheelTest, RestartsAfterGoingIdle) {
+    int fired = 0;
+    wheel->schedule(5ms, ioc.get_executor(), [&fired]() { ++fired; });
+    runFor(200ms);
+    ASSERT_EQ(fired, 1);
+    wheel->schedule(5ms, ioc.get_executor(), [&fired]() { ++fired; });
+    runFor(200ms);
+    EXPECT_EQ(fired, 2);
+}
+
+TEST_F(TimingWheelTest, ArmAndCancelFromManyThreads) {
+    // Tables arm and cancel from their own strands while the wheel ticks on another thread
+    std::atomic<int> fired{0};
+    auto guard = boost::asio::make_work_guard(ioc);
+    std::thread runner([this]() { ioc.run(); });
+    std::vector<std::thread> tables;
+    for (int t = 0; t < 4; ++t) {
+        tables.emplace_back([this, &fired]() {
+            auto strand = boost::asio::make_strand(ioc);
+            for (int i = 0; i < 1000; ++i) {
+                auto handle = wheel->schedule(std::chrono::milliseconds(i % 20), strand, [&fired]() { ++fired; });
+                if (i % 2 == 0) {
+                    wheel->cancel(handle);
+                }
+            }
+        });
+    }
+    for (auto& table : tables) {
+        table.join();
+    }
+    auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (wheel->pending() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    guard.reset();
+    runner.join();
+    // A cancel can lose the race with an expiry that was already due
+    EXPECT_GE(fired, 2000);
+    EXPECT_LE(fired, 4000);
+    EXPECT_EQ(wheel->pending(), 0u);
+}
+
+TEST(TimingWheelPoolTest, HandsOutWheelsRoundRobin) {
+    boost::asio::io_context ioc;
+    TimingWheelPool pool(ioc, 3);
+    EXPECT_EQ(pool.size(), 3u);
+    auto first = pool.next();
+    auto second = pool.next();
+    auto third = pool.next();
+    EXPECT_NE(first, second);
+    EXPECT_NE(second, third);
+    EXPECT_EQ(pool.next(), first);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "self_play.hpp"
+#include <stdexcept>
+
+namespace {
+
+sim::SelfPlayConfig randomConfig(uint64_t hands, uint64_t tables, uint64_t seed) {
+    sim::SelfPlayConfig config;
+    config.hands = hands;
+    config.tables = tables;
+    config.seed = seed;
+    config.strategies = {sim::strategyByName("random"), sim::strategyByName("random")};
+    return config;
+}
+
+// Always calls (checks when nothing is owed)
+class CallingStation : public sim::Strategy {
+public:
+    sim::Decision decide(const Hand&, const Player&, const sim::DecisionContext& context) override {
+        return {Action::CALL, context.call_amount};
+    }
+};
+
+} // namespace
+
+TEST(SelfPlayTest, RandomPlayConservesChips) {
+    ThreadPool pool(4);
+    sim::SelfPlayResult result = sim::runSelfPlay(randomConfig(20000, 8, 42), pool);
+    EXPECT_EQ(result.hands, 20000u);
+    EXPECT_EQ(result.invariant_violations, 0u);
+    EXPECT_EQ(result.rejected_actions, 0u);
+    EXPECT_EQ(result.net_chips[0] + result.net_chips[1], 0);
+    EXPECT_GT(result.showdowns, 0u);
+}
+
+#ifndef POKER_SECURE_DECK
+TEST(SelfPlayTest, SeededRunsAreReproducibleAcrossThreadCounts) {
+    ThreadPool one(1);
+    ThreadPool four(4);
+    sim::SelfPlayResult a = sim::runSelfPlay(randomConfig(5000, 6, 7), one);
+    sim::SelfPlayResult b = sim::runSelfPlay(randomConfig(5000, 6, 7), four);
+    EXPECT_EQ(a.net_chips, b.net_chips);
+    EXPECT_EQ(a.showdowns, b.showdowns);
+}
+#endif
+
+TEST(SelfPlayTest, CallingStationsAlwaysReachShowdown) {
+    ThreadPool pool(2);
+    sim::SelfPlayConfig config = randomConfig(1000, 2, 3);
+    auto station = [](uint64_t) { return std::make_unique<CallingStation>(); };
+    config.strategies = {station, station};
+    sim::SelfPlayResult result = sim::runSelfPlay(config, pool);
+    EXPECT_EQ(result.showdowns, 1000u);
+    EXPECT_EQ(result.invariant_violations, 0u);
+}
+
+TEST(SelfPlayTest, UnknownStrategyAndMissingFactory) {
+    EXPECT_FALSE(sim::strategyByName("shark"));
+    ThreadPool pool(1);
+    sim::SelfPlayConfig config;
+    EXPECT_THROW(sim::runSelfPlay(config, pool), std::invalid_argument);
+}
@@ -0,0 +1,92 @@
+#include "core/equity.hpp"
+#include "core/preflop_table.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Computes exact heads-up preflop equities for every pair of two-card combos
+// by full board enumeration, then averages them into the 169x169 class matrix.
+// Matchups equal up to a suit relabelling are enumerated once.
+//
+// Usage: preflop_table_gen <output-file> [threads]
+
+namespace {
+
+using Matchup = std::pair<uint64_t, uint64_t>;
+
+// Smallest (hero, villain) image of a matchup over all suit relabellings
+Matchup canonicalMatchup(CardSet hero, CardSet villain) {
+    std::array<int, NUM_SUITS> perm = {0, 1, 2, 3};
+    Matchup best{hero.bits(), villain.bits()};
+    while (std::next_permutation(perm.begin(), perm.end())) {
+        best = std::min(best, Matchup{hero.permuteSuits(perm).bits(), villain.permuteSuits(perm).bits()});
+    }
+    return best;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <output-file> [threads]\n";
+        return 1;
+    }
+    const std::string output = argv[1];
+    const std::size_t threads = argc == 3 ? std::stoul(argv[2]) : 0;
+
+    constexpr int COMBOS = PreflopEquityTable::NUM_COMBOS;
+    constexpr int CLASSES = PreflopEquityTable::NUM_CLASSES;
+    ThreadPool pool(threads);
+
+    std::vector<float> combo_equity(static_cast<std::size_t>(COMBOS) * COMBOS, std::nanf(""));
+    std::map<Matchup, float> solved;
+    for (int a = 0; a < COMBOS; ++a) {
+        CardSet hero = PreflopEquityTable::comboAt(a);
+        for (int b = a + 1; b < COMBOS; ++b) {
+            CardSet villain = PreflopEquityTable::comboAt(b);
+            if (hero.intersects(villain)) continue;
+
+            Matchup key = canonicalMatchup(hero, villain);
+            auto it = solved.find(key);
+            if (it == solved.end()) {
+                equity::EquityRequest request;
+                request.hole_cards = {hero, villain};
+                float value = static_cast<float>(equity::enumerate(request, pool).players[0].equity);
+                it = solved.emplace(key, value).first;
+            }
+            combo_equity[static_cast<std::size_t>(a) * COMBOS + b] = it->second;
+            combo_equity[static_cast<std::size_t>(b) * COMBOS + a] = 1.0f - it->second;
+        }
+        std::cerr << "\rcombo " << (a + 1) << "/" << COMBOS << ", " << solved.size() << " distinct matchups"
+                  << std::flush;
+    }
+    std::cerr << "\n";
+
+    // Every disjoint combo pair of two classes is equally likely to be dealt
+    std::vector<double> class_sum(static_cast<std::size_t>(CLASSES) * CLASSES, 0.0);
+    std::vector<int> class_pairs(class_sum.size(), 0);
+    for (int a = 0; a < COMBOS; ++a) {
+        int hero_class = PreflopEquityTable::classIndex(PreflopEquityTable::comboAt(a));
+        for (int b = 0; b < COMBOS; ++b) {
+            float value = combo_equity[static_cast<std::size_t>(a) * COMBOS + b];
+            if (std::isnan(value)) continue;
+            std::size_t cell = static_cast<std::size_t>(hero_class) * CLASSES +
+                               PreflopEquityTable::classIndex(PreflopEquityTable::comboAt(b));
+            class_sum[cell] += value;
+            ++class_pairs[cell];
+        }
+    }
+    std::vector<float> class_equity(class_sum.size());
+    for (std::size_t i = 0; i < class_sum.size(); ++i) {
+        class_equity[i] = static_cast<float>(class_sum[i] / class_pairs[i]);
+    }
+
+    PreflopEquityTable::write(output, class_equity, combo_equity);
+    std::cerr << "wrote " << output << "\n";
+    return 0;
+}